@@ -303,6 +303,19 @@ namespace Serializer
 		NetSerializeImpl(Map, Ar, Props, std::make_index_sequence<sizeof...(TArgs)>{}, Args...);
 	}
 
+	// also records the bit position where each argument ends
+	template<size_t... Is, typename... TArgs>
+	void NetSerializeBoundsImpl(UPackageMap* Map, FBitWriter& Ar, const TArray<FProperty*>& Props, int32* OutBitEnds, std::index_sequence<Is...>, TArgs&... Args)
+	{
+		int Temp[] = {0, (TNetSerializer<TArgs>::NetSerialize(Map, Ar, Props[Is], Args), OutBitEnds[Is] = int32(Ar.GetNumBits()), 0)...};
+		(void)(Temp);
+	}
+	template<typename... TArgs>
+	FORCEINLINE void NetSerializeWithPropBounds(UPackageMap* Map, FBitWriter& Ar, const TArray<FProperty*>& Props, int32* OutBitEnds, TArgs&... Args)
+	{
+		NetSerializeBoundsImpl(Map, Ar, Props, OutBitEnds, std::make_index_sequence<sizeof...(TArgs)>{}, Args...);
+	}
+
 	template<typename... TArgs>
 	FORCEINLINE void NetSerialize(FArchive& Ar, TArgs&... Args)
 	{
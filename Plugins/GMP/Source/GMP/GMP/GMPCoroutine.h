@@ -0,0 +1,184 @@
+//  Copyright GenericMessagePlugin, Inc. All Rights Reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GMPHub.h"
+
+#if GMP_WITH_COROUTINE
+#include <coroutine>
+#include <tuple>
+
+/*
+	FGMPCoroutine ARequester::Flow()
+	{
+		auto Rsp = co_await Hub.Request<int32, FString>(MSGKEY("Shop.Buy"), this, ItemId);
+		if (!Rsp)
+			co_return;  // nobody answered
+		auto& [Code, Msg] = *Rsp;
+	}
+	the frame is destroyed without resuming when the request is dropped (timeout or eviction),
+	or when the UObject running the coroutine dies before the response arrives.
+*/
+namespace GMP
+{
+namespace Internal
+{
+	GMP_API void* AllocCoroutineFrame(size_t Size);
+	GMP_API void FreeCoroutineFrame(void* Ptr, size_t Size);
+}  // namespace Internal
+
+struct FGMPCoroutine
+{
+	struct promise_type
+	{
+		// member coroutines of UObjects are owned by the object
+		FWeakObjectPtr Owner;
+		bool bHasOwner = false;
+
+		promise_type() = default;
+		template<typename T, typename... TArgs>
+		promise_type(T& Self, TArgs&&...)
+		{
+			SetOwner(Self);
+		}
+
+		FGMPCoroutine get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { GMP_CHECK(false); }
+
+		static void* operator new(size_t Size) { return Internal::AllocCoroutineFrame(Size); }
+		static void operator delete(void* Ptr, size_t Size) { Internal::FreeCoroutineFrame(Ptr, Size); }
+
+	private:
+		template<typename T>
+		void SetOwner(T& Self)
+		{
+			if constexpr (std::is_base_of_v<UObject, std::decay_t<T>>)
+			{
+				Owner = &Self;
+				bHasOwner = true;
+			}
+			else if constexpr (std::is_pointer_v<std::decay_t<T>>)
+			{
+				if constexpr (std::is_base_of_v<UObject, std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>>)
+				{
+					Owner = Self;
+					bHasOwner = !!Self;
+				}
+			}
+		}
+	};
+};
+
+template<typename... Rsps>
+class [[nodiscard]] TGMPRequestAwaiter
+{
+	static_assert(sizeof...(Rsps) > 0, "Request needs the response types");
+
+public:
+	using FResult = TOptional<std::tuple<std::decay_t<Rsps>...>>;
+
+	template<typename... TArgs>
+	TGMPRequestAwaiter(FMessageHub& InHub, const FMSGKEYFind& MessageKey, FSigSource InSigSrc, TArgs&&... Args)
+		: Hub(&InHub)
+		, State(MakeShared<FState>())
+	{
+		State->Awaiter = this;
+		// a responder answering synchronously fills Result before we ever suspend
+		Sequence = InHub.RequestMessage(MessageKey, InSigSrc, [Guard = FDropGuard{State}](const std::decay_t<Rsps>&... Rsp) {
+			if (auto Awaiter = Guard.Take())
+				Awaiter->OnResponse(Rsp...);
+		}, std::forward<TArgs>(Args)...);
+	}
+	~TGMPRequestAwaiter()
+	{
+		// a pending response outliving this awaiter (never awaited, or its frame torn down) must not reach it
+		State->Awaiter = nullptr;
+	}
+	TGMPRequestAwaiter(const TGMPRequestAwaiter&) = delete;
+	TGMPRequestAwaiter& operator=(const TGMPRequestAwaiter&) = delete;
+
+	bool await_ready() const { return !Sequence.IsValid() || Result.IsSet(); }
+
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> InHandle)
+	{
+		Handle = InHandle;
+		if constexpr (std::is_same_v<Promise, FGMPCoroutine::promise_type>)
+		{
+			Owner = InHandle.promise().Owner;
+			bHasOwner = InHandle.promise().bHasOwner;
+			// the pending response is dropped once the owner dies, which destroys the frame through the guard
+			if (bHasOwner)
+				Hub->SetResponseOwner(Sequence, Owner.Get());
+		}
+	}
+
+	FResult await_resume() { return MoveTemp(Result); }
+
+private:
+	// shared by the awaiter and the pending response, cleared when the awaiter goes away
+	struct FState
+	{
+		TGMPRequestAwaiter* Awaiter = nullptr;
+	};
+
+	// lives in the pending FResponseSig, destroys the suspended frame when the request is dropped unanswered
+	struct FDropGuard
+	{
+		mutable TSharedPtr<FState> State;
+
+		FDropGuard(TSharedPtr<FState> In)
+			: State(MoveTemp(In))
+		{
+		}
+		FDropGuard(FDropGuard&& Other) = default;
+		FDropGuard(const FDropGuard&) = delete;
+		~FDropGuard()
+		{
+			if (auto Awaiter = Take())
+			{
+				if (Awaiter->Handle)
+					Awaiter->Handle.destroy();
+			}
+		}
+		TGMPRequestAwaiter* Take() const
+		{
+			auto Ret = State ? State->Awaiter : nullptr;
+			State.Reset();
+			return Ret;
+		}
+	};
+
+	void OnResponse(const std::decay_t<Rsps>&... Rsp)
+	{
+		Result.Emplace(Rsp...);
+		if (!Handle)
+			return;
+
+		if (bHasOwner && !Owner.IsValid())
+			Handle.destroy();
+		else
+			Handle.resume();
+	}
+
+	FMessageHub* Hub;
+	TSharedRef<FState> State;
+	FGMPKey Sequence;
+	FResult Result;
+	std::coroutine_handle<> Handle;
+	FWeakObjectPtr Owner;
+	bool bHasOwner = false;
+};
+
+template<typename... Rsps, typename... TArgs>
+TGMPRequestAwaiter<Rsps...> FMessageHub::Request(const FMSGKEYFind& MessageKey, FSigSource InSigSrc, TArgs&&... Args)
+{
+	return TGMPRequestAwaiter<Rsps...>(*this, MessageKey, InSigSrc, std::forward<TArgs>(Args)...);
+}
+}  // namespace GMP
+
+using FGMPCoroutine = GMP::FGMPCoroutine;
+#endif
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GMPLocalSharedStorage.h"
 
+#include "Containers/Queue.h"
 #include "Delegates/Delegate.h"
 #include "GMPSignals.inl"
 #include "GMPSignalsInc.h"
@@ -12,6 +13,8 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/ScriptMacros.h"
 
+#include <atomic>
+
 #include "GMPHub.generated.h"
 
 #ifndef GMP_REDUCE_IGMPSIGNALS_CAST
@@ -24,6 +27,10 @@ struct FGMPStructUnion;
 namespace GMP
 {
 class FMessageHub;
+#if GMP_WITH_COROUTINE
+template<typename... Rsps>
+class TGMPRequestAwaiter;
+#endif
 using FGMPMessageSig = TGMPFunction<void(FMessageBody&)>;
 
 struct FResponseRec
@@ -176,6 +183,29 @@ namespace Hub
 	{
 		return FGMPPropStackRef::MakePropStackRefArray(InAddr, InStruct);
 	}
+	GMP_API void LaunchListenerTask(const FGMPListenOptions& Options, TUniqueFunction<void()>&& Task);
+	// drops the queued listener tasks and waits a bounded time for the running ones, called at module shutdown
+	GMP_API void ShutdownListenerTasks();
+
+	// shared by an async listener and its queued tasks
+	struct FAsyncListenerState
+	{
+		std::atomic<bool> bAlive{true};
+	};
+	// owned by the game thread callback, removing the listener never blocks:
+	// the queued tasks are skipped while a task already running is allowed to finish
+	struct FAsyncListenerGuard
+	{
+		TSharedRef<FAsyncListenerState, ESPMode::ThreadSafe> State = MakeShared<FAsyncListenerState, ESPMode::ThreadSafe>();
+		~FAsyncListenerGuard() { State->bAlive.store(false); }
+	};
+
+	template<typename F, typename Tup, typename... TArgs, size_t... Is>
+	FORCEINLINE void InvokeWithOwnedTuple(F& Func, Tup& InTup, std::tuple<TArgs...>*, std::index_sequence<Is...>*)
+	{
+		Func(static_cast<ForwardParam<TArgs>>(std::get<Is>(InTup))...);
+	}
+
 	template<typename FuncType>
 	struct TMessageTraits
 	{
@@ -202,6 +232,29 @@ namespace Hub
 		{
 			return [Func{std::move(Func)}](FMessageBody& Body) { Hub::Invoke<Tuple>(static_cast<const AttachedFunctorType&>(Func), Body); };
 		}
+
+		template<typename... TArgs, size_t... Is>
+		static std::tuple<std::decay_t<TArgs>...> CopyParams(FMessageBody& Body, std::tuple<TArgs...>*, std::index_sequence<Is...>*)
+		{
+			GMP_CHECK_SLOW(Body.GetParamCount() >= sizeof...(TArgs));
+			return std::tuple<std::decay_t<TArgs>...>(Body.GetParamVerify<TArgs>(Is)...);
+		}
+
+		// the arguments are copied on the game thread, the functor itself runs on a task
+		template<typename F>
+		static FGMPMessageSig MakeAsyncCallback(F&& Func, FGMPListenOptions Options)
+		{
+			using SeqIndex = std::make_index_sequence<TSig::TupleSize>;
+			auto SharedFunc = MakeShared<std::decay_t<F>, ESPMode::ThreadSafe>(std::forward<F>(Func));
+			auto Guard = MakeShared<FAsyncListenerGuard, ESPMode::ThreadSafe>();
+			return [SharedFunc, Guard, Options](FMessageBody& Body) {
+				auto Payload = CopyParams(Body, (Tuple*)nullptr, (SeqIndex*)nullptr);
+				LaunchListenerTask(Options, [SharedFunc, State{Guard->State}, Payload{MoveTemp(Payload)}]() mutable {
+					if (State->bAlive.load())
+						InvokeWithOwnedTuple(*SharedFunc, Payload, (Tuple*)nullptr, (SeqIndex*)nullptr);
+				});
+			};
+		}
 	};
 
 	template<typename FuncType, typename = void>
@@ -235,6 +288,46 @@ namespace Hub
 			return MyTraits::MakeCallback(InMsgHub, std::move(Func), std::conditional_t<bIsSingleShot, std::true_type, std::false_type>());
 		}
 		static decltype(auto) MakeNames() { return FMessageBody::MakeStaticNames((Tuple*)nullptr, std::make_index_sequence<TupleSize - (bIsSingleShot ? 1 : 0)>()); }
+		static constexpr uint64 MakeFingerprint() { return FMessageBody::MakeFingerprint((Tuple*)nullptr, std::make_index_sequence<TupleSize - (bIsSingleShot ? 1 : 0)>()); }
+
+		template<typename T, typename F>
+		static decltype(auto) ToFunctor(T* Listener, F&& Func)
+		{
+			return std::forward<F>(Func);
+		}
+		template<typename T, typename R, typename F, typename... TArgs>
+		static auto ToFunctor(T* Listener, R (F::*Op)(TArgs...))
+		{
+			GMP_CHECK_SLOW(Listener);
+			return [=](ForwardParam<TArgs>... Args) { return (Listener->*Op)(static_cast<TArgs>(Args)...); };
+		}
+		template<typename T, typename R, typename F, typename... TArgs>
+		static auto ToFunctor(T* Listener, R (F::*Op)(TArgs...) const)
+		{
+			GMP_CHECK_SLOW(Listener);
+			return [=](ForwardParam<TArgs>... Args) { return (Listener->*Op)(static_cast<TArgs>(Args)...); };
+		}
+
+		template<typename T, typename F>
+		static FGMPMessageSig MakeCallback(FMessageHub* InMsgHub, T* Listener, F&& Func, const FGMPListenOptions& Options)
+		{
+			return MakeCallbackWithAffinity(InMsgHub, Listener, std::forward<F>(Func), Options, std::conditional_t<bIsSingleShot, std::true_type, std::false_type>());
+		}
+		template<typename T, typename F>
+		static FGMPMessageSig MakeCallbackWithAffinity(FMessageHub* InMsgHub, T* Listener, F&& Func, const FGMPListenOptions& Options, std::false_type)
+		{
+			// UObjects can be collected while a task is queued, they always listen on the game thread
+			constexpr bool bIsUObject = std::is_base_of<UObject, std::decay_t<T>>::value;
+			if (Options.Affinity != EGMPListenAffinity::GameThread && ensureMsgf(!bIsUObject, TEXT("UObject listeners always run on the game thread")))
+				return MyTraits::MakeAsyncCallback(ToFunctor(Listener, std::forward<F>(Func)), Options);
+			return MakeCallback(InMsgHub, Listener, std::forward<F>(Func));
+		}
+		template<typename T, typename F>
+		static FGMPMessageSig MakeCallbackWithAffinity(FMessageHub* InMsgHub, T* Listener, F&& Func, const FGMPListenOptions& Options, std::true_type)
+		{
+			ensureMsgf(Options.Affinity == EGMPListenAffinity::GameThread, TEXT("responders always run on the game thread"));
+			return MakeCallback(InMsgHub, Listener, std::forward<F>(Func));
+		}
 	};
 
 	struct DefaultTraits
@@ -258,6 +351,11 @@ namespace Hub
 		{
 			return FMessageBody::MakeStaticNames((Tup*)nullptr, std::make_index_sequence<std::tuple_size<Tup>::value>());
 		}
+		template<typename Tup>
+		static constexpr uint64 MakeFingerprint(Tup*)
+		{
+			return FMessageBody::MakeFingerprint((Tup*)nullptr, std::make_index_sequence<std::tuple_size<Tup>::value>());
+		}
 
 		FORCEINLINE static auto MakeSingleShot(const FName&, const void*) { return nullptr; }
 	};
@@ -288,6 +386,11 @@ namespace Hub
 			static_assert(TupleSize > 0, "err");
 			return FMessageBody::MakeStaticNames((Tup*)nullptr, std::make_index_sequence<TupleSize - 1>());
 		}
+		template<typename Tup>
+		static constexpr uint64 MakeFingerprint(Tup*)
+		{
+			return FMessageBody::MakeFingerprint((Tup*)nullptr, std::make_index_sequence<std::tuple_size<Tup>::value - 1>());
+		}
 
 		template<typename F>
 		static FResponseSig MakeSingleShotImpl(const FName& SingleShotId, F&& OnRsp);
@@ -310,6 +413,51 @@ namespace Hub
 	{
 	};
 
+	// storage of a posted argument, UObject pointers become weak pointers
+	template<typename T>
+	struct TPostedObjectArg
+	{
+		TPostedObjectArg(T* In)
+			: Weak(In)
+			, bNull(!In)
+		{
+		}
+		TWeakObjectPtr<T> Weak;
+		T* Ptr = nullptr;
+		bool bNull;
+	};
+	template<typename T, typename Enable = void>
+	struct TPostedArg
+	{
+		using Type = T;
+	};
+	template<typename T>
+	struct TPostedArg<T*, std::enable_if_t<std::is_base_of<UObject, T>::value>>
+	{
+		using Type = TPostedObjectArg<T>;
+	};
+	template<typename T>
+	FORCEINLINE bool IsPostedArgStale(const T&)
+	{
+		return false;
+	}
+	template<typename T>
+	FORCEINLINE bool IsPostedArgStale(const TPostedObjectArg<T>& Arg)
+	{
+		return !Arg.bNull && !Arg.Weak.IsValid();
+	}
+	template<typename T>
+	FORCEINLINE T& GetPostedArg(T& Arg)
+	{
+		return Arg;
+	}
+	template<typename T>
+	FORCEINLINE T*& GetPostedArg(TPostedObjectArg<T>& Arg)
+	{
+		Arg.Ptr = Arg.Weak.Get();
+		return Arg.Ptr;
+	}
+
 	template<typename F>
 	static bool ApplyMessageBoy(FMessageBody& Body, const F& Lambda, bool bNative = true)
 	{
@@ -436,7 +584,7 @@ private:
 			return false;
 
 		TraceMessageKey(MessageKey, InSigSrc);
-		if (auto Ptr = FindSig(MessageSignals, MessageKey))
+		if (auto Ptr = FindSigOrWildcard(MessageKey))
 		{
 			return !!NotifyMessageImpl(Ptr, MessageKey, InSigSrc, Param);
 		}
@@ -463,7 +611,7 @@ private:
 #if GMP_WITH_DYNAMIC_CALL_CHECK
 		const auto& ArgNames = SendTraits::MakeNames(TupRef);
 		const FArrayTypeNames* OldParams = nullptr;
-		if (!IsSignatureCompatible(true, MessageKey, ArgNames, OldParams, GetNativeTagType()))
+		if (!IsNativeSignatureCompatible(true, MessageKey, MessageKey.GetSlot(), SendTraits::MakeFingerprint((TupleType*)nullptr), ArgNames, OldParams))
 		{
 			ensureAlwaysMsgf(false, TEXT("SignatureMismatch On Send %s"), *MessageKey.ToString());
 			return Ret;
@@ -471,7 +619,9 @@ private:
 #endif
 		TraceMessageKey(MessageKey, InSigSrc);
 
-		auto Ptr = GetSig<(!!Flags && !SendTraits::bIsSingleShot)>(MessageSignals, MessageKey);
+		auto Ptr = GetSlotSig<(!!Flags && !SendTraits::bIsSingleShot)>(MessageKey);
+		if (!Ptr && !SendTraits::bIsSingleShot && WildcardKeys.Num() > 0)
+			Ptr = FindWildcardSig(MessageKey);
 #if GMP_WITH_MSG_HOLDER
 		bool bIsAlive = IsAlive(Ptr);
 #endif
@@ -529,6 +679,25 @@ public:
 		return SendObjectMessageWrapper<0>(MessageKey, InSigSrc, Forward<TArgs>(Args)...);
 	}
 
+	// callable from any thread, arguments are copied and sent on the game thread in one batch per frame (gmp.post.drainPhase)
+	// UObject pointer arguments are held weakly, the message is dropped at the drain if one of them was destroyed
+	template<typename... TArgs>
+	void PostObjectMessage(const FMSGKEY& MessageKey, FSigSource InSigSrc, TArgs&&... Args)
+	{
+		using TupleType = std::tuple<typename Hub::TPostedArg<std::decay_t<TArgs>>::Type...>;
+		PostMessageImpl(MessageKey, InSigSrc, [Tup{TupleType(std::forward<TArgs>(Args)...)}](FMessageHub& Hub, const FName& Key, FSigSource SigSrc) mutable {
+			Hub.SendPostedMessage(Key, SigSrc, Tup, std::index_sequence_for<TArgs...>{});
+		});
+	}
+
+	template<typename... TArgs>
+	FORCEINLINE void PostMessage(const FMSGKEY& MessageKey, TArgs&&... Args)
+	{
+		PostObjectMessage(MessageKey, FSigSource::NullSigSrc, std::forward<TArgs>(Args)...);
+	}
+
+	void DrainPostedMessages();
+
 #if GMP_WITH_MSG_HOLDER
 	template<typename... TArgs>
 	FORCEINLINE FGMPKey StoreObjectMessage(const FMSGKEYFind& MessageKey, FSigSource InSigSrc, TArgs&&... Args)
@@ -558,20 +727,24 @@ public:
 #if GMP_WITH_DYNAMIC_CALL_CHECK
 		const auto& ArgNames = ListenTraits::MakeNames();
 		const FArrayTypeNames* OldParams = nullptr;
-		if (!IsSignatureCompatible(false, MessageKey, ArgNames, OldParams, GetNativeTagType()))
+		if (!IsNativeSignatureCompatible(false, MessageKey, INDEX_NONE, ListenTraits::MakeFingerprint(), ArgNames, OldParams))
 		{
 			ensureAlwaysMsgf(false, TEXT("SignatureMismatch On Listen %s"), *MessageKey.ToString());
 			return 0;
 		}
 
 #endif
+		// a typed listener would read the arguments of every concrete key under the wildcard as its own
+		if (!ensureAlwaysMsgf(!IsWildcardKey(MessageKey), TEXT("typed listeners cannot listen on wildcard key %s, listen with FMessageBody& via ScriptListenMessage"), *MessageKey.ToString()))
+			return 0;
+
 		GMP_IF_CONSTEXPR(ListenTraits::bIsSingleShot)
 		{
 			ensureAlways(GIsEditor || !CallbackMarks.Contains(MessageKey));
 			CallbackMarks.Add(MessageKey);
 		}
 
-		return ListenMessageImpl(MessageKey, InSigSrc, ToSigListener(Listener), ListenTraits::MakeCallback(this, Listener, std::forward<F>(Func)), Options);
+		return ListenMessageImpl(MessageKey, InSigSrc, ToSigListener(Listener), ListenTraits::MakeCallback(this, Listener, std::forward<F>(Func), Options), Options);
 	}
 
 	FORCEINLINE void UnbindMessage(const FMSGKEYFind& MessageKey, FGMPKey InKey)
@@ -596,6 +769,12 @@ public:
 	FGMPKey IsAlive(const FName& MessageId, const UObject* Listener, FSigSource InSigSrc = FSigSource::NullSigSrc) const;
 	bool IsValidHub() const;
 	bool IsResponseOn(FGMPKey Key) const;
+	// "*" or ending in ".*", only FMessageBody listeners may listen on them since the concrete keys differ in signature
+	static bool IsWildcardKey(const FName& MessageKey);
+	// drops the pending response of RequestSequence if it is not answered in time, then calls OnTimeout
+	bool SetResponseTimeout(FGMPKey RequestSequence, float TimeoutSeconds, TGMPFunction<void()> OnTimeout = {});
+	// drops the pending response of RequestSequence once Owner is destroyed
+	bool SetResponseOwner(FGMPKey RequestSequence, const UObject* Owner);
 
 	static const TCHAR* GetNativeTagType();
 	static const TCHAR* GetScriptTagType();
@@ -603,6 +782,8 @@ public:
 
 	static bool IsSignatureCompatible(bool bCall, const FName& MessageId, const FArrayTypeNames& TypeNames, const FArrayTypeNames*& OldTypes, const TCHAR* TagType = nullptr);
 	static bool IsSingleshotCompatible(bool bCall, const FName& MessageId, const FArrayTypeNames& TypeNames, const FArrayTypeNames*& OldTypes, const TCHAR* TagType = nullptr);
+	// native call sites only, script and blueprint calls keep the full comparison every time
+	static bool IsNativeSignatureCompatible(bool bCall, const FName& MessageId, int32 Slot, uint64 Fingerprint, const FArrayTypeNames& TypeNames, const FArrayTypeNames*& OldTypes);
 
 public:
 	template<typename F, typename... TArgs>
@@ -616,7 +797,7 @@ public:
 #if GMP_WITH_DYNAMIC_CALL_CHECK
 		const auto& ArgNames = FMessageBody::MakeStaticNamesImpl<std::decay_t<TArgs>...>();
 		const FArrayTypeNames* OldParams = nullptr;
-		if (!IsSignatureCompatible(true, MessageKey, ArgNames, OldParams, GetNativeTagType()))
+		if (!IsNativeSignatureCompatible(true, MessageKey, MessageKey.GetSlot(), FMessageBody::MakeFingerprintImpl<std::decay_t<TArgs>...>(), ArgNames, OldParams))
 		{
 			ensureAlwaysMsgf(false, TEXT("SignatureMismatch On Request %s"), *MessageKey.ToString());
 			return 0;
@@ -641,6 +822,12 @@ public:
 		return {};
 	}
 
+#if GMP_WITH_COROUTINE
+	// co_await from a FGMPCoroutine to get TOptional<std::tuple<Rsps...>>, defined in GMPCoroutine.h
+	template<typename... Rsps, typename... TArgs>
+	TGMPRequestAwaiter<Rsps...> Request(const FMSGKEYFind& MessageKey, FSigSource InSigSrc, TArgs&&... Args);
+#endif
+
 	template<typename... TArgs>
 	void ResponseMessage(FGMPKey RequestSequence, TArgs&&... Args)
 	{
@@ -759,7 +946,62 @@ public:
 private:
 	FGMPSignalMap MessageSignals;
 
+	// signals addressed by FMSGKEYFind::GetSlot(), filled on the first lookup by name
+	TArray<FSignalBase> SlotSignals;
+	void BindSlotSig(int32 Slot, const FSignalBase& Sig);
+	template<bool bAdd>
+	FORCEINLINE FSignalBase* GetSlotSig(const FMSGKEYFind& MessageKey)
+	{
+		const int32 Slot = MessageKey.GetSlot();
+		if (SlotSignals.IsValidIndex(Slot) && SlotSignals[Slot].Store.IsValid())
+			return &SlotSignals[Slot];
+
+		auto Ptr = GetSig<bAdd>(MessageSignals, MessageKey);
+		if (Ptr && Slot != INDEX_NONE)
+			BindSlotSig(Slot, *Ptr);
+		return Ptr;
+	}
+
+	using FPostedSender = TUniqueFunction<void(FMessageHub&, const FName&, FSigSource)>;
+	struct FPostedMessage
+	{
+		FName MessageKey;
+		FSigSource SigSrc;
+		// messages from a source destroyed before the drain are dropped
+		FWeakObjectPtr WeakSrc;
+		FPostedSender Sender;
+	};
+	TQueue<FPostedMessage, EQueueMode::Mpsc> PostedMessages;
+	std::atomic<int32> NumPostedMessages{0};
+	void PostMessageImpl(const FName& MessageKey, FSigSource InSigSrc, FPostedSender&& Sender);
+	template<typename TupleType, size_t... Is>
+	FORCEINLINE void SendPostedMessage(const FName& MessageKey, FSigSource InSigSrc, TupleType& Tup, std::index_sequence<Is...>)
+	{
+		bool bStale = false;
+		(void)std::initializer_list<int>{(bStale |= Hub::IsPostedArgStale(std::get<Is>(Tup)), 0)...};
+		if (bStale)
+			return;
+		SendObjectMessage(FMSGKEYFind(FMSGKEY(MessageKey)), InSigSrc, Hub::GetPostedArg(std::get<Is>(Tup))...);
+	}
+
 	TSet<FName> CallbackMarks;
+
+	// listeners on "Combat.*" also receive Combat.Hit, Combat.Hit.Crit... and "*" receives everything
+	// the matching wildcard signals of a key are resolved once, so a notify walks one extra array
+	TSet<FName> WildcardKeys;
+	TMap<FName, TArray<FSignalBase>> WildcardRoutes;
+	// keys nobody listens to exactly are notified on this empty signal, only their routes fire
+	FSignalBase WildcardCarrier;
+	void AddWildcardKey(const FName& MessageKey);
+	void PruneWildcardRoutes(const FName& MessageKey, const FSignalBase* Ptr);
+	const TArray<FSignalBase>& ResolveWildcardRoute(const FName& MessageKey);
+	FSignalBase* FindWildcardSig(const FName& MessageKey);
+	FORCEINLINE FSignalBase* FindSigOrWildcard(const FName& MessageKey)
+	{
+		auto Ptr = FindSig(MessageSignals, MessageKey);
+		return (Ptr || WildcardKeys.Num() == 0) ? Ptr : FindWildcardSig(MessageKey);
+	}
+
 	void PushMsgBody(FMessageBody* Body);
 	FMessageBody* PopMsgBody();
 	TArray<FMessageBody*, TInlineAllocator<8>> MessageBodyStack;
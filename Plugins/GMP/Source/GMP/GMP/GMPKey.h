@@ -26,6 +26,15 @@ struct FGMPListenOrder
 	GMP_API static FGMPListenOrder MinOrder;
 };
 
+// where a native listener runs, listeners off the game thread get an owned copy of the arguments
+enum class EGMPListenAffinity : uint8
+{
+	GameThread,
+	AnyThread,
+	// tasks of the same pipe run one after another
+	NamedPipe,
+};
+
 struct FGMPListenOptions : public FGMPListenOrder
 {
 	FGMPListenOptions() {}
@@ -42,6 +51,20 @@ struct FGMPListenOptions : public FGMPListenOrder
 	}
 
 	int32 Times = -1;
+	EGMPListenAffinity Affinity = EGMPListenAffinity::GameThread;
+	FName PipeName;
+
+	FGMPListenOptions& RunOnAnyThread()
+	{
+		Affinity = EGMPListenAffinity::AnyThread;
+		return *this;
+	}
+	FGMPListenOptions& RunOnPipe(FName InPipeName)
+	{
+		Affinity = EGMPListenAffinity::NamedPipe;
+		PipeName = InPipeName;
+		return *this;
+	}
 
 	GMP_API static FGMPListenOptions Default;
 };
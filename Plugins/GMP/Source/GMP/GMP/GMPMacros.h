@@ -106,6 +106,20 @@ extern GMP_API int32 GEnableGMPLogging;
 #define GMP_CHECK_SLOW checkSlow
 #endif
 
+// native call sites fingerprint their parameter types at compile time, each key and fingerprint is compared by name once
+#if !defined(GMP_WITH_SIGNATURE_FINGERPRINT)
+#define GMP_WITH_SIGNATURE_FINGERPRINT GMP_WITH_DYNAMIC_CALL_CHECK
+#endif
+
+// co_await support for requests, see GMPCoroutine.h
+#if !defined(GMP_WITH_COROUTINE)
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define GMP_WITH_COROUTINE 1
+#else
+#define GMP_WITH_COROUTINE 0
+#endif
+#endif
+
 #if !defined(GMP_WITH_NO_CLASS_CHECK)
 #define GMP_WITH_NO_CLASS_CHECK UE_BUILD_SHIPPING
 #endif
@@ -22,15 +22,47 @@ inline FName ToMessageKey(const FName& Name, EFindName FindType = FNAME_Add)
 {
 	return Name;
 }
+namespace Detail
+{
+	// same text as BytesToHex, without the temporary FString
+	template<typename T>
+	FName IntegerToMessageKey(T Key, EFindName FindType)
+	{
+		TCHAR Buffer[sizeof(T) * 2 + 1];
+		const uint8* Bytes = reinterpret_cast<const uint8*>(&Key);
+		for (int32 Idx = 0; Idx < int32(sizeof(T)); ++Idx)
+		{
+			Buffer[Idx * 2] = NibbleToTChar(Bytes[Idx] >> 4);
+			Buffer[Idx * 2 + 1] = NibbleToTChar(Bytes[Idx] & 15);
+		}
+		Buffer[sizeof(T) * 2] = TEXT('\0');
+		return FName(Buffer, FindType);
+	}
+}  // namespace Detail
 inline FName ToMessageKey(uint64_t Key, EFindName FindType = FNAME_Add)
 {
-	return FName(*BytesToHex(reinterpret_cast<const uint8*>(&Key), sizeof(Key)), FindType);
+	return Detail::IntegerToMessageKey(Key, FindType);
 }
 inline FName ToMessageKey(uint32_t Key, EFindName FindType = FNAME_Add)
 {
-	return FName(*BytesToHex(reinterpret_cast<const uint8*>(&Key), sizeof(Key)), FindType);
+	return Detail::IntegerToMessageKey(Key, FindType);
 }
 
+// dense per-process index of a message key, used to address the signal of each hub without hashing
+GMP_API int32 RegisterMessageKeySlot(FName MessageKey);
+GMP_API int32 NumMessageKeySlots();
+
+struct FMSGKEYSlotted : public FName
+{
+	template<typename CharType>
+	explicit FMSGKEYSlotted(const CharType* Str)
+		: FName(Str)
+		, Slot(RegisterMessageKeySlot(*this))
+	{
+	}
+	int32 Slot;
+};
+
 template<EFindName EType>
 struct TMSGKEYBase : public FName
 {
@@ -59,6 +91,11 @@ struct FMSGKEYFind : public FMSGKEYAny
 		: FMSGKEYAny(In)
 	{
 	}
+	FMSGKEYFind(const FMSGKEYSlotted& In)
+		: FMSGKEYAny(static_cast<const FName&>(In))
+		, Slot(In.Slot)
+	{
+	}
 #if !WITH_EDITOR
 	explicit FMSGKEYFind(const FMSGKEYAny& In)
 		: FMSGKEYAny(In)
@@ -71,9 +108,17 @@ protected:
 	friend class MSGKEY_TYPE;
 #endif
 	using FMSGKEYAny::FMSGKEYAny;
+
+public:
+	int32 GetSlot() const { return Slot; }
+
+private:
+	int32 Slot = INDEX_NONE;
 };
 template<typename T>
 const FName GMP_MSGKEY_HOLDER{T::Get()};
+template<typename T>
+const FMSGKEYSlotted GMP_MSGKEY_SLOT_HOLDER{T::Get()};
 
 #if !defined(GMP_TRACE_MSG_STACK)
 #define GMP_TRACE_MSG_STACK (1 && WITH_EDITOR && !GMP_WITH_STATIC_MSGKEY)
@@ -81,7 +126,7 @@ const FName GMP_MSGKEY_HOLDER{T::Get()};
 
 #if GMP_WITH_STATIC_MSGKEY
 using MSGKEY_TYPE = FName;
-#define MSGKEY(str) GMP::GMP_MSGKEY_HOLDER<C_STRING_TYPE(str)>
+#define MSGKEY(str) GMP::GMP_MSGKEY_SLOT_HOLDER<C_STRING_TYPE(str)>
 #else
 class MSGKEY_TYPE
 {
@@ -23,6 +23,8 @@ namespace Proto
 	{
 		GMP_API bool UStructToProtoImpl(FArchive& Ar, const UScriptStruct* Struct, const void* StructAddr);
 		GMP_API bool UStructToProtoImpl(TArray<uint8>& Out, const UScriptStruct* Struct, const void* StructAddr);
+		// streams straight from property memory to the wire, falls back to UStructToProtoImpl for unsupported layouts
+		GMP_API bool UStructToProtoWireImpl(TArray<uint8>& Out, const UScriptStruct* Struct, const void* StructAddr);
 	}  // namespace Serializer
 	template<typename T>
 	bool UStructToProto(T& Out, const UScriptStruct* Struct, const uint8* ValueAddr)
@@ -35,6 +37,11 @@ namespace Proto
 		return UStructToProto(Out, TypeTraits::StaticStruct<DataType>(), static_cast<const uint8*>(std::addressof(Data)));
 	}
 	template<typename DataType>
+	bool UStructToProtoWire(TArray<uint8>& Out, const DataType& Data)
+	{
+		return Serializer::UStructToProtoWireImpl(Out, TypeTraits::StaticStruct<DataType>(), std::addressof(Data));
+	}
+	template<typename DataType>
 	bool UStructToProtoFile(const DataType& Data, const TCHAR* Filename, bool bLowCase = true)
 	{
 		TArray<uint8> Ret;
@@ -46,6 +53,8 @@ namespace Proto
 	{
 		GMP_API bool UStructFromProtoImpl(FArchive& Ar, const UScriptStruct* Struct, void* StructAddr);
 		GMP_API bool UStructFromProtoImpl(TConstArrayView<uint8> In, const UScriptStruct* Struct, void* StructAddr);
+		// single pass counterpart of UStructToProtoWireImpl
+		GMP_API bool UStructFromProtoWireImpl(TConstArrayView<uint8> In, const UScriptStruct* Struct, void* StructAddr);
 	}  // namespace Deserializer
 	template<typename T>
 	bool UStructFromProto(T&& In, const UScriptStruct* Struct, uint8* OutStructAddr)
@@ -58,6 +67,11 @@ namespace Proto
 		return UStructFromProto(Forward<T>(In), TypeTraits::StaticStruct<DataType>(), static_cast<uint8*>(std::addressof(OutData)));
 	}
 	template<typename DataType>
+	bool UStructFromProtoWire(TConstArrayView<uint8> In, DataType& OutData)
+	{
+		return Deserializer::UStructFromProtoWireImpl(In, TypeTraits::StaticStruct<DataType>(), std::addressof(OutData));
+	}
+	template<typename DataType>
 	bool UStructFromProtoFile(const TCHAR* Filename, DataType& OutData)
 	{
 		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(Filename));
@@ -129,10 +129,15 @@ namespace Reflection
 	}
 
 	// Name --> Property
-	GMP_API bool PropertyFromString(FString TypeString, FProperty*& OutProp, bool bTemplateSub = false, bool bContainerSub = false, bool bNew = false);
+	// resolved names are memoized, lookups of a known name are a single probe and safe from any thread
+	// a name seen for the first time must be resolved on the game thread
+	GMP_API bool PropertyFromString(const FString& TypeString, FProperty*& OutProp, bool bTemplateSub = false, bool bContainerSub = false, bool bNew = false);
+	GMP_API bool PropertyFromName(FName TypeName, FProperty*& OutProp);
+	// the struct, class or enum a property refers to, looked up through containers, null for plain types
+	GMP_API UField* PropertyTypeObject(const FProperty* Prop);
 
 #if GMP_USE_NEW_PROP_FROM_STRING
-	GMP_API bool NewPropertyFromString(FString TypeString, FProperty*& OutProp, bool bTemplateSub = false, bool bContainerSub = false);
+	GMP_API bool NewPropertyFromString(const FString& TypeString, FProperty*& OutProp, bool bTemplateSub = false, bool bContainerSub = false);
 #endif
 
 	// Name --> Type
@@ -12,14 +12,27 @@
 class APlayerController;
 class UGMPRpcProxy;
 class UPackageMap;
+
+// how unreliable messages of one key are sent, frame merging and dropping need gmp.rpc.coalesce on
+enum class EGMPRpcUnreliablePolicy : uint8
+{
+	Keep,       // every message is sent
+	Latest,     // only the newest message per key and sender is sent
+	Droppable,  // discarded once gmp.rpc.unreliableFrameBytes of the frame are used up
+	Delta,      // like Latest, and only the arguments changed since the last snapshot of the key and sender are sent
+};
+
 namespace GMP
 {
 class GMP_API FRpcMessageUtils
 {
+public:
+	static void SetUnreliablePolicy(const FMSGKEY& MessageKey, EGMPRpcUnreliablePolicy Policy);
+
 protected:
 	static UPackageMap* GetPackageMap(APlayerController* PC);
 	static const int32 GetMaxBytes();
-	static void PostRPCMsg(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool Reliable = true);
+	static void PostRPCMsg(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool Reliable = true, TArrayView<const int32> ArgBitEnds = {});
 	static FString ProxyGetNameSafe(APlayerController* PC);
 	static APlayerController* GetLocalPC(const UObject* Obj);
 	static int32 GetPlayerLocalSequence(const APlayerController& PC);
@@ -51,10 +64,11 @@ protected:
 #endif
 			{
 				FGMPNetBitWriter Writer(Package, 0);
-				Serializer::NetSerializeWithProps(Package, Writer, Properties, ((std::remove_cv_t<TArgs>&)InArgs)...);
+				int32 ArgBitEnds[sizeof...(TArgs) + 1] = {0};
+				Serializer::NetSerializeWithPropBounds(Package, Writer, Properties, ArgBitEnds, ((std::remove_cv_t<TArgs>&)InArgs)...);
 				ensureWorld(PC, Writer.GetNumBits() <= GetMaxBytes() * 8);
 				if (ensureAlways(!Writer.IsError()))
-					PostRPCMsg(PC, Sender, MessageKey.ToString(), const_cast<TArray<uint8>&>(*Writer.GetBuffer()), bReliable);
+					PostRPCMsg(PC, Sender, MessageKey.ToString(), const_cast<TArray<uint8>&>(*Writer.GetBuffer()), bReliable, TArrayView<const int32>(ArgBitEnds, sizeof...(TArgs)));
 			}
 		}
 	}
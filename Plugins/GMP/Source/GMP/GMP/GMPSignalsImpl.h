@@ -5,6 +5,7 @@
 #include "CoreUObject.h"
 
 #include "Algo/AnyOf.h"
+#include "Algo/BinarySearch.h"
 #include "GMPSignals.inl"
 #include "Logging/LogMacros.h"
 #include "Misc/AssertionMacros.h"
@@ -110,6 +111,7 @@ struct FSigElmData
 	}
 	bool TestTimes() { return (Times != 0 && (Times < 0 || --Times > 0)); }
 	auto GetGMPKey() const { return GMPKey; }
+	auto GetOwner() const { return Owner; }
 
 	void SetLeftTimes(int32 InTimes) { Times = (InTimes < 0 ? -1 : InTimes); }
 	void SetListenOrder(int32 InOrder) { Order = InOrder; }
@@ -120,6 +122,7 @@ protected:
 	FGMPKey GMPKey = {};
 	int32 Times = -1;
 	int32 Order = 0;
+	FSignalStore* Owner = nullptr;
 };
 
 #define SLOT_STORAGE_INLINE_SIZE GMP_FUNCTION_PREDEFINED_ALIGN_SIZE
@@ -128,17 +131,56 @@ protected:
 #endif  // SLOT_STORAGE_INLINE_SIZE
 #define GMP_ALWAYS_USE_INLINE_SIGNAL (SLOT_STORAGE_INLINE_SIZE < GMP_FUNCTION_PREDEFINED_INLINE_SIZE)
 
+// size-classed slabs for the FSigElm of one store, slabs grow with the listener count so small stores stay small
+// game thread only, like the stores themselves
+class GMP_API FSigElmPool
+{
+public:
+	FSigElmPool() = default;
+	~FSigElmPool();
+	FSigElmPool(const FSigElmPool&) = delete;
+	FSigElmPool& operator=(const FSigElmPool&) = delete;
+
+	void* Alloc(SIZE_T Size);
+	static void Free(void* Ptr);
+
+	static constexpr int32 NumClasses = 6;
+	struct FStats
+	{
+		int64 SlabCount = 0;
+		int64 SlabBytes = 0;
+		int64 UsedBlocks[NumClasses] = {};
+		int64 FreeBlocks[NumClasses] = {};
+		int64 LargeBlocks = 0;
+		// slabs of pools destroyed while blocks were still in use
+		int64 LeakedSlabs = 0;
+		int64 LeakedBytes = 0;
+	};
+	static const FStats& GetStats();
+
+private:
+	struct FBlockHeader;
+	struct FSlab;
+	FBlockHeader* FreeLists[NumClasses] = {};
+	int32 SlabCounts[NumClasses] = {};
+	FSlab* Slabs = nullptr;
+	int32 LiveBlocks = 0;
+};
+
 class FSigElm final : public TAttachedCallableStore<FSigElmData, SLOT_STORAGE_INLINE_SIZE>
 {
-#if GMP_ALWAYS_USE_INLINE_SIGNAL
 public:
-	void* operator new(size_t Size, uint32 AdditionalSize)
+	void* operator new(size_t Size, FSigElmPool& Pool, uint32 AdditionalSize)
 	{
+#if GMP_ALWAYS_USE_INLINE_SIGNAL
 		auto AllocSize = FMath::Max(sizeof(FSigElm), offsetofINLINE() + FMath::Max((uint32)FStorageEraseBase::kAlignSize, AdditionalSize));
-		return FMemory::Malloc(AllocSize, alignof(FSigElm));
-	}
-	void operator delete(void* Ptr) { return FMemory::Free(Ptr); }
+#else
+		auto AllocSize = Size;
 #endif
+		return Pool.Alloc(AllocSize);
+	}
+	void operator delete(void* Ptr, FSigElmPool& Pool, uint32 AdditionalSize) { FSigElmPool::Free(Ptr); }
+	void operator delete(void* Ptr) { FSigElmPool::Free(Ptr); }
 
 	struct FKeyFuncs : BaseKeyFuncs<TUniquePtr<FSigElm>, FGMPKey, false>
 	{
@@ -148,20 +190,13 @@ public:
 	};
 
 private:
-	static FSigElm* Alloc(FGMPKey InKey, uint32 AdditionalSize = 0)
-	{
-#if GMP_ALWAYS_USE_INLINE_SIGNAL
-		return new (AdditionalSize) FSigElm(InKey);
-#else
-		return new FSigElm(InKey);
-#endif
-	}
+	static FSigElm* Alloc(FSigElmPool& Pool, FGMPKey InKey, uint32 AdditionalSize = 0) { return new (Pool, AdditionalSize) FSigElm(InKey); }
 	using Super = TAttachedCallableStore<FSigElmData, SLOT_STORAGE_INLINE_SIZE>;
 
 	template<typename Functor, uint32 INLINE_SIZE = sizeof(TTypedObject<std::decay_t<Functor>>)>
-	static FSigElm* Construct(FGMPKey InKey, Functor&& InFunc, int32 InTimes = -1)
+	static FSigElm* Construct(FSigElmPool& Pool, FGMPKey InKey, Functor&& InFunc, int32 InTimes = -1)
 	{
-		FSigElm* Impl = Alloc(InKey, INLINE_SIZE);
+		FSigElm* Impl = Alloc(Pool, InKey, INLINE_SIZE);
 		Impl->SetLeftTimes(InTimes);
 		Impl->BindOrMove(std::forward<Functor>(InFunc));
 		return Impl;
@@ -192,6 +227,26 @@ private:
 
 using FMsgKeyArray = TArray<FGMPKey, TInlineAllocator<8>>;
 
+// keys kept in ascending order, the listen order lives in the high bits of FGMPKey
+struct FSigElmKeyList : public TArray<FGMPKey, TInlineAllocator<1>>
+{
+	void Add(FGMPKey Key)
+	{
+		auto Idx = Algo::LowerBound(*this, Key);
+		if (!IsValidIndex(Idx) || !((*this)[Idx] == Key))
+			Insert(Key, Idx);
+	}
+	int32 Remove(FGMPKey Key)
+	{
+		auto Idx = Algo::BinarySearch(*this, Key);
+		if (Idx == INDEX_NONE)
+			return 0;
+		RemoveAt(Idx, 1, EAllowShrinking::No);
+		return 1;
+	}
+	bool Contains(FGMPKey Key) const { return Algo::BinarySearch(*this, Key) != INDEX_NONE; }
+};
+
 template<typename T>
 constexpr bool TIsSupported = !!(std::is_base_of<UObject, T>::value || std::is_base_of<FSigCollection, T>::value);
 
@@ -236,21 +291,53 @@ public:
 	}
 
 	bool IsFiring() const { return ScopeCnt != 0; }
+	FSigElmPool& GetElmPool() { return ElmPool; }
 
 private:
+	// declared first so it outlives every element released by the members below
+	FSigElmPool ElmPool;
 #if !GMP_SIGNAL_WITH_GLOBAL_SIGELMSET
 	mutable TSet<TUniquePtr<FSigElm>, FSigElm::FKeyFuncs> SigElmSet;
 #endif
 
 	using FSigElmKeySet = TSet<FGMPKey, DefaultKeyFuncs<FGMPKey>, TInlineSetAllocator<1>>;
-	TMap<FSigSource, FSigElmKeySet> SourceObjs;
+	TMap<FSigSource, FSigElmKeyList> SourceObjs;
 	mutable TMap<FWeakObjectPtr, FSigElmKeySet> HandlerObjs;
+	// GFrameCounter of the last stale HandlerObjs sweep
+	uint64 HandlerSweepFrame = 0;
 	std::atomic<int32> ScopeCnt{0};
 
+	// dispatch-ready listeners sorted by FGMPKey, never mutated while firing
+	using FSigElmArray = TArray<FSigElm*>;
+	FSigElmArray DispatchElms;
+	// changes made while firing, applied when the outermost fire ends
+	FSigElmArray PendingAdds;
+	FSigElmKeySet PendingErases;
+
+	// listeners of a source merged with its world and AnySigSrc, built on first fire and dropped when any of them changes
+	struct FSourceView
+	{
+		FSigSource World;
+		FSigElmArray Elms;
+	};
+	TMap<FSigSource, TUniquePtr<FSourceView>> SourceViews;
+	// world -> sources whose view merged that world
+	TMap<FSigSource, TArray<FSigSource>> WorldViews;
+	// sources whose views were invalidated while firing
+	TArray<FSigSource, TInlineAllocator<4>> PendingViewSources;
+
+	template<typename ArrayT>
+	void MergeKeysBySrc(ArrayT& Results, FSigSource InSigSrc, FSigSource InWorld, bool bIncludeNoSrc) const;
+	const FSigElmArray& GetSourceView(FSigSource InSigSrc, FSigElmArray& Uncached);
+	void InvalidateSourceView(FSigSource InSigSrc);
+
 	FSigElm* AddSigElmImpl(FGMPKey Key, const UObject* InHandler, FSigSource InSigSrc, const TGMPFunctionRef<FSigElm*()>& Ctor);
 
 	void Reset();
 	void RemoveSigElmStorage(FGMPKey InSigKey);
+	void AddDispatchElm(FSigElm* SigElm);
+	void EraseSigElmStorage(FSigElm* SigElm);
+	void FlushPendingElms();
 	friend struct FSignalUtils;
 	friend class FSignalImpl;
 
@@ -520,7 +607,7 @@ private:
 	auto ConnectImpl(std::false_type, T* const Obj, Lambda&& Callable, FSigSource InSigSrc, FGMPListenOptions Options, FGMPKey Seq = {})
 	{
 		auto Key = Seq ? Seq : GetGMPKey(Callable, Options);
-		auto Item = Store->AddSigElm<bAllowDuplicate>(Key, ToUObject(Obj), InSigSrc, [&] { return FSigElm::Construct(Key, std::forward<Lambda>(Callable), Options.Times); });
+		auto Item = Store->AddSigElm<bAllowDuplicate>(Key, ToUObject(Obj), InSigSrc, [&] { return FSigElm::Construct(Store->GetElmPool(), Key, std::forward<Lambda>(Callable), Options.Times); });
 		return Item;
 	}
 };
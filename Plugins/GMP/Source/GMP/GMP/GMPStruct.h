@@ -492,6 +492,16 @@ namespace GMP
 using FTypedAddresses = TArray<FGMPTypedAddr, TInlineAllocator<8>>;
 using FArrayTypeNames = TArray<FName, TInlineAllocator<8>>;
 
+// FNV-1a of the function signature, which spells out the parameter types
+template<typename... Ts>
+constexpr uint64 GMPSignatureFingerprint()
+{
+	uint64 Hash = ITS::val_64_const;
+	for (const char* Str = Z_ITS_TYPE_NAME_; *Str; ++Str)
+		Hash = (Hash ^ uint64(uint8(*Str))) * ITS::prime_64_const;
+	return Hash;
+}
+
 struct GMP_API FMessageBody
 {
 	template<typename... Ts>
@@ -505,6 +515,16 @@ struct GMP_API FMessageBody
 	{
 		return MakeStaticNamesImpl<std::decay_t<std::tuple_element_t<Is, Tup>>...>();
 	}
+	template<typename... Ts>
+	static constexpr uint64 MakeFingerprintImpl()
+	{
+		return std::integral_constant<uint64, GMPSignatureFingerprint<Ts...>()>::value;
+	}
+	template<typename Tup, size_t... Is>
+	static constexpr uint64 MakeFingerprint(Tup*, const std::index_sequence<Is...>&)
+	{
+		return MakeFingerprintImpl<std::decay_t<std::tuple_element_t<Is, Tup>>...>();
+	}
 
 	FORCEINLINE auto GetSigSource() const { return CurSigSrc.TryGetUObject(); }
 
@@ -553,7 +573,13 @@ struct GMP_API FMessageBody
 	{
 		TArray<FGMPTypedAddr> Ret;
 		Ret.Reserve(Params.Num() + 4);
+		AppendFullParameters(BodyDataMask, ReserveCnt, InOutAddrs, Ret);
+		return Ret;
+	}
 
+	template<typename AllocatorType>
+	void AppendFullParameters(uint8 BodyDataMask, int32& ReserveCnt, TArray<FGMPTypedAddr>& InOutAddrs, TArray<FGMPTypedAddr, AllocatorType>& Ret) const
+	{
 		if (BodyDataMask & (1 << 0))  // 0x1
 		{
 			static const UObject* StaticSigSource;
@@ -590,7 +616,6 @@ struct GMP_API FMessageBody
 		}
 
 		Ret.Append(Params);
-		return Ret;
 	}
 
 #if WITH_EDITOR
@@ -117,6 +117,17 @@ public:
 		return NotifyWorldMessage(WorldContext->GetWorld(), K, Forward<TArgs>(Args)...);
 	}
 	
+	template<typename... TArgs>
+	FORCEINLINE static void PostObjectMessage(FSigSource InSigSrc, const MSGKEY_TYPE& K, TArgs&&... Args)
+	{
+		GetMessageHub()->PostObjectMessage(K, InSigSrc, Forward<TArgs>(Args)...);
+	}
+	template<typename... TArgs>
+	FORCEINLINE static void PostMessage(const MSGKEY_TYPE& K, TArgs&&... Args)
+	{
+		GetMessageHub()->PostMessage(K, Forward<TArgs>(Args)...);
+	}
+
 #if GMP_WITH_MSG_HOLDER
 	template<typename... TArgs>
 	FORCEINLINE static auto StoreObjectMessage(const UObject* InObj, const MSGKEY_TYPE& K, TArgs&&... Args)
@@ -360,6 +360,112 @@ namespace WorldLocals
 	using TSparseArr = TSparseArray<T, TInlineSparseArrayAllocator<4>>;
 	template<typename U>
 	using TSparseOps = TLocalOpsImpl<U, TSparseArr>;
+
+	// each world owns a block of slots and each local type gets a slot index once,
+	// so a lookup is a block pointer plus an index, blocks are freed on world teardown
+	struct FWorldLocalSlots
+	{
+		TArray<TWeakObjectPtr<UObject>> Objects;
+		TArray<TSharedPtr<void>> Shareds;
+	};
+	GMP_API int32 AllocWorldLocalSlot();
+	GMP_API FWorldLocalSlots* FindWorldLocalSlots(const UWorld* InWorld, bool bAdd);
+
+	struct FWorldSlotOps
+	{
+		template<typename T>
+		static int32 SlotIndex()
+		{
+			static const int32 Index = AllocWorldLocalSlot();
+			return Index;
+		}
+
+		template<typename T>
+		static auto& GetSlots(FWorldLocalSlots& Slots)
+		{
+			if constexpr (std::is_base_of<UObject, T>::value)
+			{
+				return Slots.Objects;
+			}
+			else
+			{
+				return Slots.Shareds;
+			}
+		}
+
+		template<typename T, typename F>
+		static T* LocalObject(const UObject* WorldContextObj, const F& Ctor)
+		{
+			UWorld* World = GetWorld(WorldContextObj);
+			GMP_CHECK(!IsGarbageCollecting() && (!World || IsValid(World)));
+			auto& Slots = GetSlots<T>(*FindWorldLocalSlots(World, true));
+			const int32 Index = SlotIndex<T>();
+			if (Slots.Num() <= Index)
+				Slots.SetNum(Index + 1);
+
+			if (!Slots[Index].IsValid())
+			{
+				// the constructor may create other locals of this world and grow the slot array, index again afterwards
+				if constexpr (std::is_base_of<UObject, T>::value)
+				{
+					GMP_CLOG(WITH_EDITOR, TEXT("Allocating local object %s in %s"), ITS::TypeWStr<T>(), *GetNameSafe(World));
+					auto Obj = Ctor();
+					Slots[Index] = Obj;
+					AddObjectReference(World, Obj);
+				}
+				else
+				{
+					GMP_CLOG(WITH_EDITOR, TEXT("Allocating shared object %s in %s"), ITS::TypeWStr<T>(), *GetNameSafe(World));
+					auto Obj = Ctor();
+					Slots[Index] = MoveTemp(Obj);
+				}
+			}
+			GMP_CHECK(Slots[Index].IsValid());
+			return static_cast<T*>(Slots[Index].Get());
+		}
+
+		template<typename T>
+		static T* LocalObject(const UObject* WorldContextObj)
+		{
+			return LocalObject<T>(WorldContextObj, [] {
+				if constexpr (std::is_base_of<UObject, T>::value)
+				{
+					return NewObject<T>();
+				}
+				else
+				{
+					return MakeShared<T>();
+				}
+			});
+		}
+
+		template<typename T>
+		static T* LocalPtr(const UObject* WorldContextObj)
+		{
+			UWorld* World = GetWorld(WorldContextObj);
+			GMP_CHECK(!IsGarbageCollecting() && (!World || IsValid(World)));
+			FWorldLocalSlots* Block = FindWorldLocalSlots(World, false);
+			if (!Block)
+				return nullptr;
+			auto& Slots = GetSlots<T>(*Block);
+			const int32 Index = SlotIndex<T>();
+			return Slots.IsValidIndex(Index) ? static_cast<T*>(Slots[Index].Get()) : nullptr;
+		}
+
+		template<typename T>
+		static bool RemoveLocal(const UObject* WorldContextObj)
+		{
+			FWorldLocalSlots* Block = FindWorldLocalSlots(GetWorld(WorldContextObj), false);
+			if (!Block)
+				return false;
+			auto& Slots = GetSlots<T>(*Block);
+			const int32 Index = SlotIndex<T>();
+			if (!Slots.IsValidIndex(Index) || !Slots[Index].IsValid())
+				return false;
+			Slots[Index].Reset();
+			return true;
+		}
+	};
 }  // namespace WorldLocals
 
 template<typename T, typename U, typename F>
@@ -388,22 +494,22 @@ bool RemoveLocal(const U* WorldContextObj)
 template<typename T, typename F>
 T* WorldLocalObject(const UObject* WorldContextObj, const F& Ctor)
 {
-	return GMP::WorldLocals::TInlineOps<UWorld>::template LocalObject<T>(WorldContextObj, Ctor);
+	return GMP::WorldLocals::FWorldSlotOps::template LocalObject<T>(WorldContextObj, Ctor);
 }
 template<typename T>
 T* WorldLocalObject(const UObject* WorldContextObj)
 {
-	return GMP::WorldLocals::TInlineOps<UWorld>::template LocalObject<T>(WorldContextObj);
+	return GMP::WorldLocals::FWorldSlotOps::template LocalObject<T>(WorldContextObj);
 }
 template<typename T>
 T* WorldLocalPtr(const UObject* WorldContextObj)
 {
-	return GMP::WorldLocals::TInlineOps<UWorld>::template LocalPtr<T>(WorldContextObj);
+	return GMP::WorldLocals::FWorldSlotOps::template LocalPtr<T>(WorldContextObj);
 }
 template<typename T>
 bool RemoveWorldLocal(const UObject* WorldContextObj)
 {
-	return GMP::WorldLocals::TInlineOps<UWorld>::template RemoveLocal<T>(WorldContextObj);
+	return GMP::WorldLocals::FWorldSlotOps::template RemoveLocal<T>(WorldContextObj);
 }
 
 template<typename T, typename F>
@@ -317,6 +317,93 @@ static bool bLogGMPBPExecution = false;
 static FAutoConsoleVariableRef CVar_DrawAbilityVisualizer(TEXT("GMP.LogGMPBPExecution"), bLogGMPBPExecution, TEXT("log each blueprint gmp exectuion"), ECVF_Default);
 #endif
 extern bool IsGMPModuleInited();
+
+// parameters of a blueprint listener, resolved at listen time and checked once per message signature
+struct FBPListenerPlan
+{
+	TArray<FProperty*> Props;
+	bool bValid = true;
+#if GMP_WITH_DYNAMIC_CALL_CHECK || GMP_WITH_DYNAMIC_TYPE_CHECK
+	TArray<FName> CheckedTypes;
+#endif
+};
+
+static TSharedRef<FBPListenerPlan> MakeBPListenerPlan(UObject* Listener, UFunction* Function)
+{
+	auto Plan = MakeShared<FBPListenerPlan>();
+	for (TFieldIterator<FProperty> PropIt(Function); PropIt && PropIt->HasAnyPropertyFlags(CPF_Parm); ++PropIt)
+	{
+		const bool bIsInput = !(PropIt->HasAnyPropertyFlags(CPF_ReturnParm) || (PropIt->HasAnyPropertyFlags(CPF_OutParm) && !PropIt->HasAnyPropertyFlags(CPF_ReferenceParm) && !PropIt->HasAnyPropertyFlags(CPF_ConstParm)));
+		if (!ensureWorld(Listener, bIsInput))
+		{
+			Plan->bValid = false;
+			break;
+		}
+		Plan->Props.Add(*PropIt);
+	}
+	return Plan;
+}
+
+static bool CheckBPListenerSignature(FBPListenerPlan& Plan, UObject* Listener, TArrayView<const FGMPTypedAddr> Params, int32 OutCnt)
+{
+	if (!ensureWorld(Listener, Params.Num() >= Plan.Props.Num()))
+		return false;
+
+#if GMP_WITH_DYNAMIC_CALL_CHECK || GMP_WITH_DYNAMIC_TYPE_CHECK
+	auto IsChecked = [&] {
+		if (Plan.CheckedTypes.Num() != Params.Num())
+			return false;
+		for (int32 Idx = 0; Idx < Params.Num(); ++Idx)
+		{
+			if (Plan.CheckedTypes[Idx] != Params[Idx].TypeName)
+				return false;
+		}
+		return true;
+	};
+	if (IsChecked())
+		return true;
+
+	for (int32 PropIdx = 0; PropIdx < Plan.Props.Num(); ++PropIdx)
+	{
+		FProperty* Prop = Plan.Props[PropIdx];
+#if GMP_WITH_DYNAMIC_TYPE_CHECK
+		if (Params[PropIdx].TypeName != NAME_GMPSkipValidate && !(ensure(FNameSuccession::IsTypeCompatible(Reflection::GetPropertyName(Prop, true), Params[PropIdx].TypeName))))
+			return false;
+#endif
+#if GMP_WITH_DYNAMIC_CALL_CHECK
+		if (PropIdx >= OutCnt)
+		{
+			UEnum* EnumPtr = nullptr;
+			auto ByteProp = CastField<FByteProperty>(Prop);
+			if (ByteProp)
+			{
+				EnumPtr = ByteProp->GetIntPropertyEnum();
+			}
+			else if (auto EnumProp = CastField<FEnumProperty>(Prop))
+			{
+				ByteProp = CastField<FByteProperty>(EnumProp->GetUnderlyingProperty());
+				ensureWorld(Listener, ByteProp || EnumProp->GetUnderlyingProperty()->IsEnum());
+				EnumPtr = EnumProp->GetEnum();
+			}
+
+			if (EnumPtr)
+			{
+				ensureWorld(Listener, EnumPtr->GetCppForm() == UEnum::ECppForm::EnumClass);
+				ensureWorld(Listener, Params[PropIdx].TypeName == TClass2Name<uint8>::GetFName() || Params[PropIdx].TypeName == Class2Name::TTraitsEnumBase::GetFName(EnumPtr, 1) || Params[PropIdx].TypeName == *EnumPtr->CppType);
+			}
+		}
+#endif
+	}
+
+	Plan.CheckedTypes.Reset(Params.Num());
+	for (auto& Param : Params)
+		Plan.CheckedTypes.Add(Param.TypeName);
+#endif
+	return true;
+}
+
+template<typename FillType>
+static bool CallMessageFunctionImpl(UObject* Obj, UFunction* Function, const FillType& FillParms);
 }  // namespace GMP
 
 bool UGMPBPLib::UnlistenMessage(const FString& MessageId, UObject* Listener, UGMPManager* Mgr, UObject* Obj)
@@ -530,6 +617,13 @@ FGMPTypedAddr UGMPBPLib::ListenMessageViaKey(UObject* Listener, FName MessageKey
 			break;
 		}
 
+		// the event parameters are typed, the concrete keys under a wildcard are not
+		if (!ensureWorld(World, !FMessageHub::IsWildcardKey(MessageKey)))
+		{
+			FFrame::KismetExecutionMessage(TEXT("Events cannot listen on wildcard keys"), ELogVerbosity::Error);
+			break;
+		}
+
 		auto NetMode = World->GetNetMode();
 		if (EnumHasAllFlags((EMessageAuthorityType)Type, EMessageTypeBoth))
 		{
@@ -558,50 +652,37 @@ FGMPTypedAddr UGMPBPLib::ListenMessageViaKey(UObject* Listener, FName MessageKey
 		}
 #endif
 		//GMP::FMessageHub::FTagTypeSetter SetMsgTagType(GMP::FMessageHub::GetBlueprintTagType());
+		auto Plan = MakeBPListenerPlan(Listener, Function);
 		auto Id = Mgr->GetHub().ScriptListenMessage(
 			SigSource,
 			MessageKey,
 			Listener,
-			[Listener, Function, BodyDataMask](FMessageBody& Msg) {
+			[Listener, Function, BodyDataMask, Plan](FMessageBody& Msg) {
+				if (!Plan->bValid)
+					return;
+
 				int32 OutCnt = 0;
 				TArray<FGMPTypedAddr> InnerArr;
-				auto Params = Msg.MakeFullParameters(BodyDataMask, OutCnt, InnerArr);
+				TArray<FGMPTypedAddr, TInlineAllocator<16>> Params;
+				Msg.AppendFullParameters(BodyDataMask, OutCnt, InnerArr, Params);
 #if GMP_LOG_BP_INVOKE
 				GMP_CLOG(bLogGMPBPExecution, TEXT("Execute %s.%s"), *GetNameSafe(Listener), *Function->GetName());
 #endif
-#if GMP_WITH_DYNAMIC_CALL_CHECK
-				int32 PropIdx = 0;
-				for (TFieldIterator<FProperty> PropIt(Function); PropIt; ++PropIt)
-				{
-					const bool bIsInput = !(PropIt->HasAnyPropertyFlags(CPF_ReturnParm) || (PropIt->HasAnyPropertyFlags(CPF_OutParm) && !PropIt->HasAnyPropertyFlags(CPF_ReferenceParm) && !PropIt->HasAnyPropertyFlags(CPF_ConstParm)));
-					if (!ensureWorld(Listener, bIsInput && Params.IsValidIndex(PropIdx)))
-						return;
+				if (!CheckBPListenerSignature(*Plan, Listener, Params, OutCnt))
+					return;
 
-					if (PropIdx >= OutCnt)
+				// parameters are copied straight into the zeroed parms frame
+				CallMessageFunctionImpl(Listener, Function, [&](UFunction*, void* Parms) {
+					for (int32 Idx = 0; Idx < Plan->Props.Num(); ++Idx)
 					{
-						UEnum* EnumPtr = nullptr;
-						auto ByteProp = CastField<FByteProperty>(*PropIt);
-						if (ByteProp)
-						{
-							EnumPtr = ByteProp->GetIntPropertyEnum();
-						}
-						else if (auto EnumProp = CastField<FEnumProperty>(*PropIt))
-						{
-							ByteProp = CastField<FByteProperty>(EnumProp->GetUnderlyingProperty());
-							ensureWorld(Listener, ByteProp || EnumProp->GetUnderlyingProperty()->IsEnum());
-							EnumPtr = EnumProp->GetEnum();
-						}
-
-						if (EnumPtr)
-						{
-							ensureWorld(Listener, EnumPtr->GetCppForm() == UEnum::ECppForm::EnumClass);
-							ensureWorld(Listener, Params[PropIdx].TypeName == TClass2Name<uint8>::GetFName() || Params[PropIdx].TypeName == Class2Name::TTraitsEnumBase::GetFName(EnumPtr, 1) || Params[PropIdx].TypeName == *EnumPtr->CppType);
-						}
+						FProperty* Prop = Plan->Props[Idx];
+						void* Dst = Prop->ContainerPtrToValuePtr<void>(Parms);
+						if (!Prop->HasAnyPropertyFlags(CPF_ZeroConstructor))
+							Prop->InitializeValue(Dst);
+						Prop->CopyCompleteValue(Dst, Params[Idx].ToAddr());
 					}
-					++PropIdx;
-				}
-#endif
-				CallMessageFunction(Listener, Function, Params);
+					return true;
+				});
 			},
 			{Times, Order});
 		if (!Id)
@@ -1319,6 +1400,12 @@ bool UGMPBPLib::CallEventDelegate(UObject* Obj, const FName EventName, const TAr
 DECLARE_CYCLE_STAT(TEXT("Blueprint Time(GMP)"), STAT_BlueprintTimeGMP, STATGROUP_Game);
 
 bool UGMPBPLib::CallMessageFunction(UObject* Obj, UFunction* Function, const TArray<FGMPTypedAddr>& Params, uint64 WritebackFlags)
+{
+	return GMP::CallMessageFunctionImpl(Obj, Function, [&Params](UFunction* InFunc, void* Parms) { return MessageToFrame(InFunc, Parms, Params); });
+}
+
+template<typename FillType>
+bool GMP::CallMessageFunctionImpl(UObject* Obj, UFunction* Function, const FillType& FillParms)
 {
 	checkf(!Obj->IsUnreachable(), TEXT("%s  Function: '%s'"), *Obj->GetFullName(), *Function->GetPathName());
 	checkf(!FUObjectThreadContext::Get().IsRoutingPostLoad, TEXT("Cannot call UnrealScript (%s - %s) while PostLoading objects"), *Obj->GetFullName(), *Function->GetFullName());
@@ -1393,7 +1480,7 @@ bool UGMPBPLib::CallMessageFunction(UObject* Obj, UFunction* Function, const TAr
 	{
 		Parms = FMemory_Alloca_Aligned(Function->ParmsSize, Function->GetMinAlignment());
 		FMemory::Memzero(Parms, Function->ParmsSize);
-		if (!ensureAlways(MessageToFrame(Function, Parms, Params)))
+		if (!ensureAlways(FillParms(Function, Parms)))
 			return false;
 	}
 	GMP_CHECK_SLOW((Function->ParmsSize == 0) || (Parms != nullptr));
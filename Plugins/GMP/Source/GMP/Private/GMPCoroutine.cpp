@@ -0,0 +1,64 @@
+//  Copyright GenericMessagePlugin, Inc. All Rights Reserved.
+
+#include "GMPCoroutine.h"
+
+#if GMP_WITH_COROUTINE
+namespace GMP
+{
+namespace Internal
+{
+	// frames are recycled per thread in 64 byte classes, larger frames go to the allocator
+	class FCoroutineFramePool
+	{
+	public:
+		static constexpr size_t Granularity = 64;
+		static constexpr int32 NumClasses = 32;
+		static constexpr int32 MaxFreePerClass = 64;
+		static constexpr size_t Alignment = 16;
+
+		~FCoroutineFramePool()
+		{
+			for (auto& List : FreeLists)
+			{
+				for (void* Ptr : List)
+					FMemory::Free(Ptr);
+			}
+		}
+
+		static int32 ClassOf(size_t Size) { return int32((Size + Granularity - 1) / Granularity) - 1; }
+
+		void* Alloc(size_t Size)
+		{
+			const int32 Class = ClassOf(Size);
+			if (Class >= NumClasses)
+				return FMemory::Malloc(Size, Alignment);
+			if (FreeLists[Class].Num() > 0)
+				return FreeLists[Class].Pop(EAllowShrinking::No);
+			return FMemory::Malloc((Class + 1) * Granularity, Alignment);
+		}
+
+		void Free(void* Ptr, size_t Size)
+		{
+			const int32 Class = ClassOf(Size);
+			if (Class >= NumClasses || FreeLists[Class].Num() >= MaxFreePerClass)
+				FMemory::Free(Ptr);
+			else
+				FreeLists[Class].Add(Ptr);
+		}
+
+	private:
+		TArray<void*> FreeLists[NumClasses];
+	};
+	static thread_local FCoroutineFramePool CoroutineFramePool;
+
+	void* AllocCoroutineFrame(size_t Size)
+	{
+		return CoroutineFramePool.Alloc(Size);
+	}
+	void FreeCoroutineFrame(void* Ptr, size_t Size)
+	{
+		CoroutineFramePool.Free(Ptr, Size);
+	}
+}  // namespace Internal
+}  // namespace GMP
+#endif
@@ -6,6 +6,7 @@
 
 #include "Algo/BinarySearch.h"
 #include "Algo/ForEach.h"
+#include "Async/Async.h"
 #include "Engine/UserDefinedStruct.h"
 #include "GMPMeta.h"
 #include "GMPSignalsImpl.h"
@@ -13,6 +14,8 @@
 #include "GMPUtils.h"
 #include "GMPWorldLocals.h"
 #include "HAL/ThreadSingleton.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
 #include "Misc/ScopeExit.h"
 #include "UObject/ObjectKey.h"
 #include "UObject/TextProperty.h"
@@ -20,6 +23,7 @@
 #include "UObject/UnrealType.h"
 #include "UnrealCompatibility.h"
 #include "GMPUnion.h"
+#include "XConsoleManager.h"
 
 #if UE_4_23_OR_LATER
 #include "Containers/LockFreeList.h"
@@ -201,6 +205,156 @@ namespace GMP
 			return Types;
 		}
 
+#if GMP_WITH_SIGNATURE_FINGERPRINT
+		// native fingerprints that already passed the comparison by name, emptied with the sends and recvs
+		struct FVerifiedFingerprints
+		{
+			// a key may be sent with a few compatible signatures, the oldest one is replaced beyond the capacity
+			struct FFingerprintSet
+			{
+				static constexpr int32 Capacity = 4;
+				uint64 Fingerprints[Capacity] = {};
+				int32 Num = 0;
+
+				bool Contains(uint64 Fingerprint) const
+				{
+					for (int32 Idx = 0; Idx < FMath::Min(Num, Capacity); ++Idx)
+					{
+						if (Fingerprints[Idx] == Fingerprint)
+							return true;
+					}
+					return false;
+				}
+				void Add(uint64 Fingerprint)
+				{
+					if (!Contains(Fingerprint))
+						Fingerprints[Num++ % Capacity] = Fingerprint;
+				}
+			};
+			TArray<FFingerprintSet> BySlot;
+			TMap<FName, FFingerprintSet> ByName;
+
+			bool Contains(const FName& MessageId, int32 Slot, uint64 Fingerprint) const
+			{
+				if (Slot != INDEX_NONE)
+					return BySlot.IsValidIndex(Slot) && BySlot[Slot].Contains(Fingerprint);
+				auto Find = ByName.Find(MessageId);
+				return Find && Find->Contains(Fingerprint);
+			}
+			void Add(const FName& MessageId, int32 Slot, uint64 Fingerprint)
+			{
+				if (Slot != INDEX_NONE)
+				{
+					if (Slot >= BySlot.Num())
+						BySlot.SetNum(FMath::Max(Slot + 1, NumMessageKeySlots()));
+					BySlot[Slot].Add(Fingerprint);
+				}
+				else
+				{
+					ByName.FindOrAdd(MessageId).Add(Fingerprint);
+				}
+			}
+			void Empty()
+			{
+				BySlot.Empty();
+				ByName.Empty();
+			}
+		};
+		template<bool bSend>
+		FVerifiedFingerprints& GetVerifiedFingerprints()
+		{
+			static FVerifiedFingerprints Fingerprints;
+			return Fingerprints;
+		}
+		void ResetVerifiedFingerprints()
+		{
+			GetVerifiedFingerprints<true>().Empty();
+			GetVerifiedFingerprints<false>().Empty();
+		}
+#else
+		FORCEINLINE void ResetVerifiedFingerprints() {}
+#endif
+
+		// a serial queue on the task graph, only one task of a pipe runs at a time
+		struct FListenerPipe
+		{
+			TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Tasks;
+			std::atomic<int32> NumTasks{0};
+
+			void Launch(TUniqueFunction<void()>&& Task);
+		};
+		static TMap<FName, TUniquePtr<FListenerPipe>> ListenerPipes;
+		static std::atomic<bool> bListenerTasksShutdown{false};
+
+		void FListenerPipe::Launch(TUniqueFunction<void()>&& Task)
+		{
+			Tasks.Enqueue(MoveTemp(Task));
+			if (NumTasks++ == 0)
+			{
+				AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this] {
+					do
+					{
+						TUniqueFunction<void()> Next;
+						if (Tasks.Dequeue(Next) && !bListenerTasksShutdown.load())
+							Next();
+					} while (--NumTasks > 0);
+				});
+			}
+		}
+
+		void LaunchListenerTask(const FGMPListenOptions& Options, TUniqueFunction<void()>&& Task)
+		{
+			GMP_CHECK(IsInGameThread());
+			if (bListenerTasksShutdown.load())
+				return;
+
+			if (Options.Affinity == EGMPListenAffinity::NamedPipe)
+			{
+				auto& Pipe = ListenerPipes.FindOrAdd(Options.PipeName);
+				if (!Pipe)
+					Pipe = MakeUnique<FListenerPipe>();
+				Pipe->Launch(MoveTemp(Task));
+			}
+			else
+			{
+				AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Task{MoveTemp(Task)}] {
+					if (!bListenerTasksShutdown.load())
+						Task();
+				});
+			}
+		}
+
+		void ShutdownListenerTasks()
+		{
+			bListenerTasksShutdown.store(true);
+
+			// the queued tasks are skipped from now on, only the running ones are waited for
+			const double WaitUntil = FPlatformTime::Seconds() + 1.0;
+			bool bDrained = false;
+			while (!bDrained)
+			{
+				bDrained = true;
+				for (auto& Pair : ListenerPipes)
+					bDrained &= Pair.Value->NumTasks.load() == 0;
+				if (bDrained || FPlatformTime::Seconds() > WaitUntil)
+					break;
+				FPlatformProcess::Sleep(0.001f);
+			}
+
+			if (bDrained)
+			{
+				ListenerPipes.Empty();
+			}
+			else
+			{
+				// a drain loop still references its pipe, leak them rather than free under it
+				GMP_WARNING(TEXT("GMP listener pipes still busy at shutdown"));
+				for (auto& Pair : ListenerPipes)
+					Pair.Value.Release();
+				ListenerPipes.Empty();
+			}
+		}
+
 		FMessageHub::CallbackMapType& GMPResponses()
 		{
 #if 1
@@ -221,14 +375,244 @@ namespace GMP
 #endif
 		}
 
+		static float ResponseDefaultTimeout = 0.f;
+		FAutoConsoleVariableRef CVar_ResponseDefaultTimeout(TEXT("gmp.response.defaultTimeout"), ResponseDefaultTimeout, TEXT("seconds before an unanswered request is dropped, 0 keeps it until answered"));
+		static int32 ResponseMaxPending = 0;
+		FAutoConsoleVariableRef CVar_ResponseMaxPending(TEXT("gmp.response.maxPending"), ResponseMaxPending, TEXT("max pending responses, the oldest requests are dropped beyond it, 0 for no limit"));
+
+		// hashed hierarchical timer wheel, 4 levels of 64 slots in ticks of 1/32 second
+		class FResponseTimerWheel
+		{
+		public:
+			static constexpr int32 SlotBits = 6;
+			static constexpr int32 NumSlots = 1 << SlotBits;
+			static constexpr int32 NumLevels = 4;
+			static constexpr double TicksPerSecond = 32.0;
+
+			uint64 ToTick(double Seconds) const { return uint64(FMath::Max(0.0, Seconds - StartSeconds) * TicksPerSecond); }
+
+			void Add(uint64 Seq, uint64 Deadline)
+			{
+				Deadline = FMath::Max(Deadline, CurrentTick + 1);
+				const uint64 Delta = Deadline - CurrentTick;
+				int32 Level = 0;
+				while (Level < NumLevels - 1 && Delta >= (1ull << (SlotBits * (Level + 1))))
+					++Level;
+				// beyond the last level the timer is parked early and re-added when it comes up
+				const uint64 SlotTick = FMath::Min(Deadline, CurrentTick + (1ull << (SlotBits * NumLevels)) - 1);
+				Slots[Level][(SlotTick >> (SlotBits * Level)) & (NumSlots - 1)].Add({Seq, Deadline});
+			}
+
+			template<typename F>
+			void Advance(double NowSeconds, const F& OnExpired)
+			{
+				const uint64 ToTick = this->ToTick(NowSeconds);
+				while (CurrentTick < ToTick)
+				{
+					++CurrentTick;
+					for (int32 Level = 1; Level < NumLevels; ++Level)
+					{
+						if (CurrentTick & ((1ull << (SlotBits * Level)) - 1))
+							break;
+						auto Cascaded = MoveTemp(Slots[Level][(CurrentTick >> (SlotBits * Level)) & (NumSlots - 1)]);
+						for (auto& Timer : Cascaded)
+							Add(Timer.Seq, Timer.Deadline);
+					}
+
+					auto Expired = MoveTemp(Slots[0][CurrentTick & (NumSlots - 1)]);
+					for (auto& Timer : Expired)
+					{
+						if (Timer.Deadline > CurrentTick)
+							Add(Timer.Seq, Timer.Deadline);
+						else
+							OnExpired(Timer.Seq);
+					}
+				}
+			}
+
+		private:
+			struct FTimer
+			{
+				uint64 Seq;
+				uint64 Deadline;
+			};
+			TArray<FTimer> Slots[NumLevels][NumSlots];
+			uint64 CurrentTick = 0;
+			double StartSeconds = FPlatformTime::Seconds();
+		};
+
+		struct FResponseStats
+		{
+			int64 Requests = 0;
+			int64 Responded = 0;
+			int64 TimedOut = 0;
+			int64 Evicted = 0;
+			int64 Orphaned = 0;
+			int32 PeakPending = 0;
+		};
+
+		// deadlines and the eviction order of GMPResponses(), game thread only
+		struct FPendingResponses
+		{
+			FResponseTimerWheel Wheel;
+			TMap<uint64, TGMPFunction<void()>> OnTimeouts;
+			TMap<uint64, FWeakObjectPtr> Owners;
+			// request order for gmp.response.maxPending, answered sequences are compacted lazily
+			TArray<uint64> Order;
+			int32 OrderHead = 0;
+			FResponseStats Stats;
+
+			// keeps Order within twice the pending count, amortized over the requests in between
+			void CompactOrder()
+			{
+				auto& Responses = GMPResponses();
+				if (Order.Num() <= 2 * Responses.Num() + 64)
+					return;
+				Order.RemoveAt(0, OrderHead, EAllowShrinking::No);
+				Order.RemoveAll([&](uint64 Elem) { return !Responses.Contains(Elem); });
+				OrderHead = 0;
+			}
+
+			void OnRequest(uint64 Seq)
+			{
+				++Stats.Requests;
+				if (ResponseMaxPending > 0)
+				{
+					Order.Add(Seq);
+				}
+				else if (Order.Num() > 0)
+				{
+					Order.Empty();
+					OrderHead = 0;
+				}
+				if (ResponseDefaultTimeout > 0.f)
+					Wheel.Add(Seq, Wheel.ToTick(FPlatformTime::Seconds() + ResponseDefaultTimeout));
+
+				auto& Responses = GMPResponses();
+				while (ResponseMaxPending > 0 && Responses.Num() > ResponseMaxPending && OrderHead < Order.Num())
+				{
+					const uint64 Oldest = Order[OrderHead++];
+					if (Responses.Contains(Oldest))
+					{
+						++Stats.Evicted;
+						Drop(Oldest);
+					}
+				}
+				Stats.PeakPending = FMath::Max(Stats.PeakPending, Responses.Num());
+			}
+
+			void OnResponse(uint64 Seq)
+			{
+				++Stats.Responded;
+				OnTimeouts.Remove(Seq);
+				Owners.Remove(Seq);
+				CompactOrder();
+			}
+
+			void Drop(uint64 Seq)
+			{
+				Owners.Remove(Seq);
+				{
+					// destroying the callback may run arbitrary code, take it out of the map first
+					FResponseSig Dropped;
+					GMPResponses().RemoveAndCopyValue(Seq, Dropped);
+				}
+				CompactOrder();
+				TGMPFunction<void()> OnTimeout;
+				if (OnTimeouts.RemoveAndCopyValue(Seq, OnTimeout) && OnTimeout)
+					OnTimeout();
+			}
+
+			void Tick()
+			{
+				Wheel.Advance(FPlatformTime::Seconds(), [&](uint64 Seq) {
+					if (GMPResponses().Contains(Seq))
+					{
+						++Stats.TimedOut;
+						Drop(Seq);
+					}
+				});
+
+				if (Owners.Num() > 0)
+				{
+					TArray<uint64, TInlineAllocator<16>> Orphans;
+					for (auto It = Owners.CreateIterator(); It; ++It)
+					{
+						if (!GMPResponses().Contains(It->Key))
+							It.RemoveCurrent();
+						else if (!It->Value.IsValid())
+							Orphans.Add(It->Key);
+					}
+					for (uint64 Seq : Orphans)
+					{
+						++Stats.Orphaned;
+						Drop(Seq);
+					}
+				}
+			}
+
+			void Reset()
+			{
+				OnTimeouts.Empty();
+				Owners.Empty();
+				Order.Empty();
+				OrderHead = 0;
+			}
+		};
+		static FPendingResponses& GetPendingResponses()
+		{
+			static FPendingResponses PendingResponses;
+			return PendingResponses;
+		}
+		static FDelayedAutoRegisterHelper DelayRegisterResponseTimeouts(EDelayedRegisterRunPhase::EndOfEngineInit, [] {
+			FCoreDelegates::OnBeginFrame.AddLambda([] { GetPendingResponses().Tick(); });
+		});
+
+#if !UE_BUILD_SHIPPING
+		FXConsoleCommandLambdaFull XVar_GMPResponseStats(TEXT("gmp.stats.responses"), TEXT("gmp.stats.responses"), [](UWorld* InWorld, FOutputDevice& Ar) {
+			auto& Stats = GetPendingResponses().Stats;
+			Ar.Logf(TEXT("GMPResponses : %d pending (peak %d), %lld requests, %lld responded, %lld timed out, %lld evicted, %lld orphaned"),
+					GMPResponses().Num(),
+					Stats.PeakPending,
+					Stats.Requests,
+					Stats.Responded,
+					Stats.TimedOut,
+					Stats.Evicted,
+					Stats.Orphaned);
+		});
+#endif
 	}  // namespace Hub
 
+	bool FMessageHub::SetResponseTimeout(FGMPKey RequestSequence, float TimeoutSeconds, TGMPFunction<void()> OnTimeout)
+	{
+		GMP_CHECK(IsInGameThread());
+		if (!Hub::GMPResponses().Contains(RequestSequence.Key))
+			return false;
+
+		auto& Pending = Hub::GetPendingResponses();
+		Pending.Wheel.Add(RequestSequence.Key, Pending.Wheel.ToTick(FPlatformTime::Seconds() + TimeoutSeconds));
+		if (OnTimeout)
+			Pending.OnTimeouts.Add(RequestSequence.Key, MoveTemp(OnTimeout));
+		return true;
+	}
+
+	bool FMessageHub::SetResponseOwner(FGMPKey RequestSequence, const UObject* Owner)
+	{
+		GMP_CHECK(IsInGameThread());
+		if (!Owner || !Hub::GMPResponses().Contains(RequestSequence.Key))
+			return false;
+
+		Hub::GetPendingResponses().Owners.Add(RequestSequence.Key, Owner);
+		return true;
+	}
+
+	namespace Internal
+	{
+		int64 NextSequenceId();
+	}
 	FGMPKey FMessageBody::GetNextSequenceID()
 	{
-		static volatile int64 Seq = 0;
-		if (FPlatformAtomics::InterlockedAdd(&Seq, 1))
-			return FGMPKey(Seq);
-		return FGMPKey(FPlatformAtomics::InterlockedAdd(&Seq, 1));
+		return FGMPKey(Internal::NextSequenceId());
 	}
 
 	FMessageBody* FMessageHub::GetCurrentMessageBody() const
@@ -277,6 +661,60 @@ namespace GMP
 		return MessageHubs.Contains(this);
 	}
 
+	void FMessageHub::PostMessageImpl(const FName& MessageKey, FSigSource InSigSrc, FPostedSender&& Sender)
+	{
+		FPostedMessage Msg;
+		Msg.MessageKey = MessageKey;
+		Msg.SigSrc = InSigSrc;
+		if (InSigSrc.IsUObject())
+			Msg.WeakSrc = InSigSrc.TryGetUObject();
+		Msg.Sender = MoveTemp(Sender);
+		PostedMessages.Enqueue(MoveTemp(Msg));
+		++NumPostedMessages;
+	}
+
+	void FMessageHub::DrainPostedMessages()
+	{
+		GMP_CHECK(IsInGameThread());
+		// messages posted by the listeners themselves wait for the next drain
+		int32 Num = NumPostedMessages.load();
+		FPostedMessage Msg;
+		while (Num-- > 0 && PostedMessages.Dequeue(Msg))
+		{
+			--NumPostedMessages;
+			if (Msg.SigSrc.IsValid() && Msg.SigSrc.IsUObject() && Msg.WeakSrc.IsStale(false))
+				continue;
+			Msg.Sender(*this, Msg.MessageKey, Msg.SigSrc);
+		}
+	}
+
+	static int32 PostedMessagesDrainPhase = 0;
+	FAutoConsoleVariableRef CVar_PostedMessagesDrainPhase(TEXT("gmp.post.drainPhase"),
+														  PostedMessagesDrainPhase,
+														  TEXT("when messages posted from other threads are sent: 0 begin frame, 1 world tick start, 2 world post actor tick, 3 end frame"));
+	static void DrainAllPostedMessages(int32 Phase)
+	{
+		if (Phase != PostedMessagesDrainPhase)
+			return;
+
+		TArray<FMessageHub*> Hubs;
+		{
+			FMessageHubVerifier Verifier{nullptr};
+			Hubs = MessageHubs.Array();
+		}
+		for (auto Hub : Hubs)
+		{
+			if (Hub->IsValidHub())
+				Hub->DrainPostedMessages();
+		}
+	}
+	static FDelayedAutoRegisterHelper DelayRegisterPostedMessagesDrain(EDelayedRegisterRunPhase::EndOfEngineInit, [] {
+		FCoreDelegates::OnBeginFrame.AddStatic(&DrainAllPostedMessages, 0);
+		FWorldDelegates::OnWorldTickStart.AddLambda([](UWorld*, ELevelTick, float) { DrainAllPostedMessages(1); });
+		FWorldDelegates::OnWorldPostActorTick.AddLambda([](UWorld*, ELevelTick, float) { DrainAllPostedMessages(2); });
+		FCoreDelegates::OnEndFrame.AddStatic(&DrainAllPostedMessages, 3);
+	});
+
 	bool FMessageHub::IsResponseOn(FGMPKey Key) const
 	{
 		return Hub::GMPResponses().Contains(Key);
@@ -298,6 +736,7 @@ namespace GMP
 		if (bExsitResponder && ensureAlwaysMsgf(!Hub::GMPResponses().Contains(OnRsp.GetId()), TEXT("duplicate sequence %zu!"), OnRsp.GetId()))
 		{
 			Hub::GMPResponses().Emplace(OnRsp.GetId(), MoveTemp(OnRsp));
+			Hub::GetPendingResponses().OnRequest(OnRsp.GetId());
 
 			FMessageBody Msg(Param, MessageKey, InSigSrc, OnRsp.GetId());
 
@@ -332,11 +771,101 @@ namespace GMP
 		return {};
 	}
 
+	void FMessageHub::BindSlotSig(int32 Slot, const FSignalBase& Sig)
+	{
+		if (Slot >= SlotSignals.Num())
+		{
+			// size for every registered key at once so the array rarely moves during dispatch
+			SlotSignals.SetNum(FMath::Max(Slot + 1, NumMessageKeySlots()));
+		}
+		SlotSignals[Slot] = Sig;
+	}
+
+	bool FMessageHub::IsWildcardKey(const FName& MessageKey)
+	{
+		static const FName NAME_AnyKey = TEXT("*");
+		if (MessageKey == NAME_AnyKey)
+			return true;
+
+		TCHAR Buffer[NAME_SIZE];
+		const uint32 Len = MessageKey.ToString(Buffer, NAME_SIZE);
+		return Len >= 2 && Buffer[Len - 1] == TEXT('*') && Buffer[Len - 2] == TEXT('.');
+	}
+
+	void FMessageHub::AddWildcardKey(const FName& MessageKey)
+	{
+		bool bAlreadyInSet = false;
+		WildcardKeys.Add(MessageKey, &bAlreadyInSet);
+		if (bAlreadyInSet)
+			return;
+
+		// resolve every known key now instead of on its next notify
+		WildcardRoutes.Reset();
+		for (auto& Pair : MessageSignals)
+		{
+			ResolveWildcardRoute(Pair.Key);
+		}
+	}
+
+	void FMessageHub::PruneWildcardRoutes(const FName& MessageKey, const FSignalBase* Ptr)
+	{
+		if (WildcardKeys.Num() == 0 || IsAlive(Ptr))
+			return;
+
+		// the routes of any key may hold a wildcard signal, they are resolved again on their next notify
+		if (WildcardKeys.Remove(MessageKey))
+			WildcardRoutes.Reset();
+		else
+			WildcardRoutes.Remove(MessageKey);
+	}
+
+	const TArray<FSignalBase>& FMessageHub::ResolveWildcardRoute(const FName& MessageKey)
+	{
+		if (auto Find = WildcardRoutes.Find(MessageKey))
+			return *Find;
+
+		auto& Route = WildcardRoutes.Add(MessageKey);
+		if (IsWildcardKey(MessageKey))
+			return Route;
+
+		auto AddRoute = [&](const TCHAR* Key) {
+			FName WildcardKey(Key, FNAME_Find);
+			if (!WildcardKey.IsNone() && WildcardKeys.Contains(WildcardKey))
+			{
+				if (auto Sig = FindSig(MessageSignals, WildcardKey))
+					Route.Add(*Sig);
+			}
+		};
+
+		// nearest ancestor first
+		FString Key = MessageKey.ToString();
+		for (int32 Idx = Key.Len() - 1; Idx > 0; --Idx)
+		{
+			if (Key[Idx] == TEXT('.'))
+				AddRoute(*(Key.Left(Idx + 1) + TEXT('*')));
+		}
+		AddRoute(TEXT("*"));
+		return Route;
+	}
+
+	FSignalBase* FMessageHub::FindWildcardSig(const FName& MessageKey)
+	{
+		// probing must not add a signal for every key sent while a wildcard is listened
+		if (ResolveWildcardRoute(MessageKey).Num() == 0)
+			return nullptr;
+		if (!WildcardCarrier.Store)
+			WildcardCarrier.Store = FGMPMsgSignal::MakeSignals(NAME_None);
+		return &WildcardCarrier;
+	}
+
 	FGMPKey FMessageHub::ListenMessageImpl(const FName& MessageKey, FSigSource InSigSrc, FSigListener Listener, FGMPMessageSig&& Slot, FGMPListenOptions Options)
 	{
 		FGMPKey Ret;
 		if (!MessageSignals.Contains(MessageKey))
 			MessageSignals.Add(MessageKey).Store = FGMPMsgSignal::MakeSignals(MessageKey);
+		// a wildcard is dropped with its last listener and added back here
+		if (IsWildcardKey(MessageKey))
+			AddWildcardKey(MessageKey);
 
 		if (auto Ptr = static_cast<FGMPMsgSignal*>(FindSig(MessageSignals, MessageKey)))
 		{
@@ -387,6 +916,8 @@ namespace GMP
 		FGMPKey Ret;
 		if (!MessageSignals.Contains(MessageKey))
 			MessageSignals.Add(MessageKey).Store = FGMPMsgSignal::MakeSignals(MessageKey);
+		if (IsWildcardKey(MessageKey))
+			AddWildcardKey(MessageKey);
 
 		if (auto Ptr = static_cast<FGMPMsgSignal*>(FindSig(MessageSignals, MessageKey)))
 		{
@@ -425,6 +956,7 @@ namespace GMP
 			{
 				GMP_LOG(TEXT("FMessageHub::%sUnbindMessageImpl Key[%s] UnListen ID[%s]"), FTagTypeSetter::GetType().Get(TEXT("")), *MessageKey.ToString(), *InKey.ToString());
 				Ptr->Disconnect(InKey);
+				PruneWildcardRoutes(MessageKey, Ptr);
 			}
 		}
 	}
@@ -438,6 +970,7 @@ namespace GMP
 			{
 				GMP_LOG(TEXT("FMessageHub::%sUnbindMessageImpl Key[%s] UnListen Obj[%s]"), FTagTypeSetter::GetType().Get(TEXT("")), *MessageKey.ToString(), *GetNameSafe(Listener));
 				Ptr->Disconnect(Listener);
+				PruneWildcardRoutes(MessageKey, Ptr);
 			}
 		}
 	}
@@ -451,6 +984,7 @@ namespace GMP
 			{
 				GMP_LOG(TEXT("FMessageHub::%sUnbindMessageImpl Key[%s] UnListen Obj[%s] Src[%p]"), FTagTypeSetter::GetType().Get(TEXT("")), *MessageKey.ToString(), *GetNameSafe(Listener), (void*)InSigSrc.GetAddrValue());
 				Ptr->Disconnect(Listener, InSigSrc);
+				PruneWildcardRoutes(MessageKey, Ptr);
 			}
 		}
 	}
@@ -466,18 +1000,26 @@ namespace GMP
 				PopMsgBody();
 			};
 			auto SignalPtr = static_cast<FGMPMsgSignal*>(Ptr);
+			// a listener may add a wildcard and rebuild the routes while we fire
+			TArray<FSignalBase, TInlineAllocator<4>> Wildcards;
+			if (WildcardKeys.Num() > 0)
+				Wildcards.Append(ResolveWildcardRoute(MessageKey));
 #if WITH_EDITOR
 			if (GIsEditor)
 			{
 				Hub::FRecursionDetection Detector(MessageKey, InSigSrc);
 
 				auto IDs = SignalPtr->FireWithSigSource(InSigSrc, Msg);
+				for (auto& Sig : Wildcards)
+					IDs.Append(static_cast<FGMPMsgSignal&>(Sig).FireWithSigSource(InSigSrc, Msg));
 				Hub::GetHistoryCalls().FindOrAdd(MessageKey).AppendCallInfo(InSigSrc, Msg, MoveTemp(IDs));
 			}
 			else
 #endif
 			{
 				SignalPtr->FireWithSigSource(InSigSrc, Msg);
+				for (auto& Sig : Wildcards)
+					static_cast<FGMPMsgSignal&>(Sig).FireWithSigSource(InSigSrc, Msg);
 			}
 		}
 		return Seq;
@@ -1024,6 +1566,7 @@ namespace GMP
 		FResponseSig Val;
 		if (Hub::GMPResponses().RemoveAndCopyValue(RequestSequence.Key, Val))
 		{
+			Hub::GetPendingResponses().OnResponse(RequestSequence.Key);
 #if GMP_WITH_DYNAMIC_CALL_CHECK
 			const FArrayTypeNames* OldParams = nullptr;
 			FArrayTypeNames Types;
@@ -1098,6 +1641,21 @@ namespace GMP
 		return true;
 	}
 
+	bool FMessageHub::IsNativeSignatureCompatible(bool bCall, const FName& MessageId, int32 Slot, uint64 Fingerprint, const FArrayTypeNames& TypeNames, const FArrayTypeNames*& OldTypes)
+	{
+#if GMP_WITH_SIGNATURE_FINGERPRINT
+		auto& Verified = bCall ? Hub::GetVerifiedFingerprints<true>() : Hub::GetVerifiedFingerprints<false>();
+		if (Verified.Contains(MessageId, Slot, Fingerprint))
+			return true;
+		if (!IsSignatureCompatible(bCall, MessageId, TypeNames, OldTypes, GetNativeTagType()))
+			return false;
+		Verified.Add(MessageId, Slot, Fingerprint);
+		return true;
+#else
+		return IsSignatureCompatible(bCall, MessageId, TypeNames, OldTypes, GetNativeTagType());
+#endif
+	}
+
 	bool FMessageBody::IsSignatureCompatible(bool bCall, const FArrayTypeNames*& OldTypes)
 	{
 #if GMP_WITH_DYNAMIC_CALL_CHECK
@@ -1130,7 +1688,9 @@ namespace
 				GMP::Hub::GetRecvs<true>().Empty();
 				GMP::Hub::GetSends<false>().Empty();
 				GMP::Hub::GetRecvs<false>().Empty();
+				GMP::Hub::ResetVerifiedFingerprints();
 				GMP::Hub::GMPResponses().Empty();
+				GMP::Hub::GetPendingResponses().Reset();
 			});
 #if WITH_EDITOR
 			if (GIsEditor)
@@ -1141,8 +1701,10 @@ namespace
 					GMP::Hub::GetRecvs<true>().Empty();
 					GMP::Hub::GetSends<false>().Empty();
 					GMP::Hub::GetRecvs<false>().Empty();
+					GMP::Hub::ResetVerifiedFingerprints();
 					GMP::Hub::GetHistoryCalls().Empty();
 					GMP::Hub::GMPResponses().Empty();
+					GMP::Hub::GetPendingResponses().Reset();
 				});
 			}
 #endif
@@ -1156,4 +1718,4 @@ UE_ENABLE_OPTIMIZATION
 #endif
 
 
-
+
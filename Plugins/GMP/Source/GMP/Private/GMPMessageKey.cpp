@@ -2,6 +2,7 @@
 #include "GMPMessageKey.h"
 #include "GMPSignalsImpl.h"
 #include "GMPStruct.h"
+#include "Misc/ScopeRWLock.h"
 
 namespace GMP
 {
@@ -27,6 +28,39 @@ namespace GMP
 	}
 
 #endif
+	// filled while the slotted MSGKEYs initialize, which may happen on any thread for function-local statics
+	static FRWLock MessageKeySlotsLock;
+	static TMap<FName, int32>& GetMessageKeySlots()
+	{
+		static TMap<FName, int32> MessageKeySlots;
+		return MessageKeySlots;
+	}
+
+	int32 NumMessageKeySlots()
+	{
+		FRWScopeLock ScopeLock(MessageKeySlotsLock, SLT_ReadOnly);
+		return GetMessageKeySlots().Num();
+	}
+
+	int32 RegisterMessageKeySlot(FName MessageKey)
+	{
+		if (MessageKey.IsNone())
+			return INDEX_NONE;
+
+		auto& MessageKeySlots = GetMessageKeySlots();
+		{
+			FRWScopeLock ScopeLock(MessageKeySlotsLock, SLT_ReadOnly);
+			if (auto Find = MessageKeySlots.Find(MessageKey))
+				return *Find;
+		}
+		FRWScopeLock ScopeLock(MessageKeySlotsLock, SLT_Write);
+		if (auto Find = MessageKeySlots.Find(MessageKey))
+			return *Find;
+		const int32 Slot = MessageKeySlots.Num();
+		MessageKeySlots.Add(MessageKey, Slot);
+		return Slot;
+	}
+
 	const TCHAR* DebugCurrentMsgFileLine()
 	{
 #if GMP_TRACE_MSG_STACK
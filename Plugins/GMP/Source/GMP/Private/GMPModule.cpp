@@ -102,6 +102,82 @@ namespace WorldLocals
 		return Ret ? Ret : GetGameWorldChecked(false);
 	}
 
+	static int32 NumWorldLocalSlots = 0;
+	int32 AllocWorldLocalSlot()
+	{
+		GMP_CHECK(IsInGameThread());
+		return NumWorldLocalSlots++;
+	}
+
+	struct FWorldLocalBlocks
+	{
+		struct FBlock
+		{
+			TWeakObjectPtr<const UWorld> World;
+			FWorldLocalSlots Slots;
+		};
+		TMap<const UWorld*, TUniquePtr<FBlock>> Blocks;
+		const UWorld* LastWorld = nullptr;
+		FBlock* LastBlock = nullptr;
+
+		void Remove(const UWorld* InWorld)
+		{
+			if (LastWorld == InWorld)
+			{
+				LastWorld = nullptr;
+				LastBlock = nullptr;
+			}
+			Blocks.Remove(InWorld);
+		}
+	};
+	static FWorldLocalBlocks WorldLocalBlocks;
+
+	FWorldLocalSlots* FindWorldLocalSlots(const UWorld* InWorld, bool bAdd)
+	{
+		auto& Ref = WorldLocalBlocks;
+		auto IsStale = [InWorld](const FWorldLocalBlocks::FBlock& InBlock) { return InWorld && !InBlock.World.IsValid(); };
+		if (Ref.LastBlock && Ref.LastWorld == InWorld && !IsStale(*Ref.LastBlock))
+			return &Ref.LastBlock->Slots;
+
+		auto* Block = Ref.Blocks.Find(InWorld);
+		// a block left behind by a world created and destroyed without teardown
+		if (Block && IsStale(**Block))
+		{
+			Ref.Remove(InWorld);
+			Block = nullptr;
+		}
+		if (!Block)
+		{
+			if (!bAdd)
+				return nullptr;
+
+			if (TrueOnFirstCall([] {}))
+			{
+				// object locals stay readable from EndPlay and cleanup code, the block goes once the world is cleaned up
+				FWorldDelegates::OnWorldBeginTearDown.AddStatic([](UWorld* World) {
+					if (auto Find = WorldLocalBlocks.Blocks.Find(World))
+						(*Find)->Slots.Shareds.Empty();
+				});
+				FWorldDelegates::OnPostWorldCleanup.AddStatic([](UWorld* World, bool, bool) { WorldLocalBlocks.Remove(World); });
+#if WITH_EDITOR
+				BindEditorEndDelegate(TDelegate<void(const bool)>::CreateLambda([](const bool) {
+					for (auto& Pair : WorldLocalBlocks.Blocks)
+						Pair.Value->Slots.Shareds.Empty();
+				}));
+#endif
+			}
+
+			auto& NewBlock = Ref.Blocks.Add(InWorld, MakeUnique<FWorldLocalBlocks::FBlock>());
+			NewBlock->World = InWorld;
+			NewBlock->Slots.Objects.Reserve(NumWorldLocalSlots);
+			Block = &NewBlock;
+		}
+
+		Ref.LastWorld = InWorld;
+		Ref.LastBlock = Block->Get();
+		return &Ref.LastBlock->Slots;
+	}
+
 	void BindEditorEndDelegate(TDelegate<void(const bool)> Delegate)
 	{
 #if WITH_EDITOR
@@ -503,6 +579,7 @@ public:
 	}
 	virtual void ShutdownModule() override
 	{
+		GMP::Hub::ShutdownListenerTasks();
 		GMP::DestroyGMPSourceAndHandlerDeleter();
 		GMP::BroadcastOnTmp(GMP::Shutdowns);
 		GMP::GMPModuleInited = false;
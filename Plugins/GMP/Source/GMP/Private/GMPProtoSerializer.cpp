@@ -5,12 +5,18 @@
 #include "GMPProtoUtils.h"
 #if defined(GMP_WITH_UPB)
 #include "HAL/PlatformFile.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
 #include "UObject/Package.h"
+#include "UObject/StructOnScope.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
 #include "UnrealCompatibility.h"
+#include "XConsoleManager.h"
 #include "upb/libupb.h"
 
+#include <atomic>
+
 #if GMP_USE_STD_VARIANT
 #include <variant>
 #else
@@ -32,6 +38,139 @@ namespace Proto
 
 	using namespace upb;
 	int32 DefaultPoolIdx = 0;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Per thread scratch blocks handed to upb as arena initial memory, an arena that fits in its block never touches the allocator
+	static int32 ArenaBlockMinSize = 4 * 1024;
+	static int32 ArenaBlockMaxSize = 256 * 1024;
+	static int32 ArenaTrimInterval = 1024;
+	FAutoConsoleVariableRef CVar_ArenaBlockMaxSize(TEXT("gmp.proto.arenaBlockMaxSize"), ArenaBlockMaxSize, TEXT("largest scratch block each thread keeps for proto arenas"));
+	FAutoConsoleVariableRef CVar_ArenaTrimInterval(TEXT("gmp.proto.arenaTrimInterval"), ArenaTrimInterval, TEXT("arena uses between two high water mark trims"));
+
+	struct FArenaPoolStats
+	{
+		std::atomic<uint64> BytesReused{0};
+		std::atomic<uint64> BytesAllocated{0};
+		std::atomic<uint64> Uses{0};
+		std::atomic<uint64> Trims{0};
+	};
+	static FArenaPoolStats ArenaPoolStats;
+
+	class FArenaBlockPool
+	{
+	public:
+		struct FBlock
+		{
+			void* Mem;
+			SIZE_T Size;
+		};
+
+		static FArenaBlockPool& Get()
+		{
+			static thread_local FArenaBlockPool Pool;
+			return Pool;
+		}
+		~FArenaBlockPool()
+		{
+			for (auto& Block : FreeBlocks)
+				FMemory::Free(Block.Mem);
+		}
+
+		FBlock Acquire()
+		{
+			ArenaPoolStats.Uses.fetch_add(1, std::memory_order_relaxed);
+			if (FreeBlocks.Num() > 0)
+			{
+				FBlock Block = FreeBlocks.Pop(EAllowShrinking::No);
+				ArenaPoolStats.BytesReused.fetch_add(Block.Size, std::memory_order_relaxed);
+				return Block;
+			}
+			ArenaPoolStats.BytesAllocated.fetch_add(BlockSize, std::memory_order_relaxed);
+			return FBlock{FMemory::Malloc(BlockSize, 16), BlockSize};
+		}
+
+		// must be read while the arena is still alive
+		static SIZE_T MeasureUsed(const FBlock& Block, upb_Arena* Arena)
+		{
+			// overflow blocks are malloced by upb and freed with the arena, size the next block to cover them
+			const SIZE_T Overflow = upb_Arena_SpaceAllocated(Arena);
+			ArenaPoolStats.BytesAllocated.fetch_add(Overflow, std::memory_order_relaxed);
+			return Overflow ? Block.Size + Overflow : Block.Size - _upb_ArenaHas(Arena);
+		}
+
+		// the arena living in the block must already be freed
+		void Release(const FBlock& Block, SIZE_T Used)
+		{
+			PeakUsed = FMath::Max(PeakUsed, Used);
+			if (Used > BlockSize)
+				BlockSize = ClampBlockSize(Used);
+
+			if (++NumUses >= ArenaTrimInterval)
+			{
+				const SIZE_T Target = ClampBlockSize(PeakUsed);
+				if (Target < BlockSize)
+				{
+					BlockSize = Target;
+					ArenaPoolStats.Trims.fetch_add(1, std::memory_order_relaxed);
+				}
+				NumUses = 0;
+				PeakUsed = 0;
+			}
+
+			if (Block.Size == BlockSize)
+				FreeBlocks.Add(Block);
+			else
+				FMemory::Free(Block.Mem);
+		}
+
+	private:
+		static SIZE_T ClampBlockSize(SIZE_T Size) { return FMath::Clamp<SIZE_T>(FMath::RoundUpToPowerOfTwo64(Size), ArenaBlockMinSize, FMath::Max(ArenaBlockMinSize, ArenaBlockMaxSize)); }
+
+		// nested serializations on the same thread each take their own block
+		TArray<FBlock, TInlineAllocator<2>> FreeBlocks;
+		SIZE_T BlockSize = ArenaBlockMinSize;
+		SIZE_T PeakUsed = 0;
+		int32 NumUses = 0;
+	};
+
+#if !UE_BUILD_SHIPPING
+	static FXConsoleCommandLambdaFull XVar_GMPProtoArenaStats(TEXT("gmp.stats.protoArena"), TEXT("gmp.stats.protoArena"), [](UWorld* InWorld, FOutputDevice& Ar) {
+		const uint64 Reused = ArenaPoolStats.BytesReused.load(std::memory_order_relaxed);
+		const uint64 Allocated = ArenaPoolStats.BytesAllocated.load(std::memory_order_relaxed);
+		Ar.Logf(TEXT("proto arenas : %llu uses, %llu bytes reused, %llu bytes allocated (%.1f%% reused), %llu trims"),
+				ArenaPoolStats.Uses.load(std::memory_order_relaxed),
+				Reused,
+				Allocated,
+				(Reused + Allocated) ? 100.0 * Reused / (Reused + Allocated) : 0.0,
+				ArenaPoolStats.Trims.load(std::memory_order_relaxed));
+	});
+#endif
+
+	// Scoped upb arena backed by the calling thread's block pool, must be released on the thread that created it
+	class FPooledArena : public FArena
+	{
+	public:
+		FPooledArena()
+			: FPooledArena(FArenaBlockPool::Get().Acquire())
+		{
+		}
+		~FPooledArena()
+		{
+			// upb keeps the arena header inside the initial block, free the arena before handing the block back
+			const SIZE_T Used = FArenaBlockPool::MeasureUsed(Block, Ptr_);
+			upb_Arena_Free(Ptr_);
+			Ptr_ = nullptr;
+			FArenaBlockPool::Get().Release(Block, Used);
+		}
+
+	private:
+		explicit FPooledArena(const FArenaBlockPool::FBlock& InBlock)
+			: FArena(static_cast<char*>(InBlock.Mem), InBlock.Size)
+			, Block(InBlock)
+		{
+		}
+		FArenaBlockPool::FBlock Block;
+	};
 	struct FGMPDefPool
 	{
 		FGMPDefPool() { DefPool.SetPlatform(PLATFORM_64BITS ? kUpb_MiniTablePlatform_64Bit : kUpb_MiniTablePlatform_32Bit); }
@@ -66,7 +205,6 @@ namespace Proto
 			if (!FileDef || FileDef.ToplevelMessageCount() == 0)
 				return;
 
-			FArena Arena;
 			for (auto i = 0; i < FileDef.ToplevelMessageCount(); ++i)
 			{
 				auto Msg = FileDef.ToplevelMessage(i);
@@ -95,8 +233,45 @@ namespace Proto
 		return PoolMap;
 	}
 
+	// Per (struct, message) binding plan: resolved once, then walked directly by encode/decode
+	struct FFieldBinding
+	{
+		FFieldDefPtr FieldDef;
+		FProperty* Prop;
+		int32 Offset;
+	};
+	struct FStructBindings
+	{
+#if WITH_EDITOR
+		// user defined structs are recompiled in place, their properties are recreated
+		const FField* ChildProperties = nullptr;
+#endif
+		TArray<FFieldBinding> Fields;
+		// whether Wire can stream this pair directly, INDEX_NONE until checked
+		std::atomic<int8> WireState{INDEX_NONE};
+	};
+	// plans are immutable once published, a rebuild replaces the entry so codecs on other threads keep their copy alive
+	using FStructBindingsRef = TSharedRef<FStructBindings, ESPMode::ThreadSafe>;
+	struct FStructBindingsMap
+	{
+		FRWLock Lock;
+		TMap<TPair<FObjectKey, const upb_MessageDef*>, FStructBindingsRef> Map;
+	};
+	static FStructBindingsMap& GetStructBindingsMap()
+	{
+		static FStructBindingsMap BindingsMap;
+		return BindingsMap;
+	}
+	static void ClearStructBindings()
+	{
+		auto& BindingsMap = GetStructBindingsMap();
+		FRWScopeLock Lock(BindingsMap.Lock, SLT_Write);
+		BindingsMap.Map.Empty();
+	}
+
 	static TUniquePtr<FGMPDefPool>& ResetDefPool(uint8 Idx = DefaultPoolIdx)
 	{
+		ClearStructBindings();
 		auto& Ref = GetDefPoolMap().FindOrAdd(Idx);
 		Ref = MakeUnique<FGMPDefPool>();
 		return Ref;
@@ -133,7 +308,7 @@ namespace Proto
 
 	bool AddProto(const char* InBuf, uint32 InSize)
 	{
-		FArena Arena;
+		FPooledArena Arena;
 		auto FileProto = FDefPool::ParseProto(StringView(InBuf, InSize), *Arena);
 		return GetDefPool()->AddProto(FileProto);
 	}
@@ -141,13 +316,14 @@ namespace Proto
 	bool AddProtos(const char* InBuf, uint32 InSize)
 	{
 		size_t DefCnt = 0;
-		auto Arena = FArena();
+		FPooledArena Arena;
 		auto& Pair = *GetDefPool();
 		FDefPool::IteratorProtoSet(FDefPool::ParseProtoSet(upb_StringView_FromDataAndSize(InBuf, InSize), Arena), [&](auto* FileProto) { DefCnt += Pair.AddProto(FileProto) ? 1 : 0; });
 		return DefCnt > 0;
 	}
 	void ClearProtos()
 	{
+		ClearStructBindings();
 		GetDefPoolMap().Empty();
 	}
 
@@ -935,24 +1111,71 @@ namespace Proto
 		return nullptr;
 	}
 
+
+	static FStructBindingsRef FindOrAddStructBindings(const FMessageDefPtr& MsgDef, const UScriptStruct* Struct)
+	{
+		auto& BindingsMap = GetStructBindingsMap();
+		const auto Key = MakeTuple(FObjectKey(Struct), *MsgDef);
+		auto IsCurrent = [&](const FStructBindings& Bindings) {
+#if WITH_EDITOR
+			if (Bindings.ChildProperties != Struct->ChildProperties)
+				return false;
+#endif
+			return Bindings.Fields.Num() == MsgDef.FieldCount();
+		};
+		{
+			FRWScopeLock Lock(BindingsMap.Lock, SLT_ReadOnly);
+			if (auto Find = BindingsMap.Map.Find(Key))
+			{
+				if (IsCurrent(**Find))
+					return *Find;
+			}
+		}
+
+		FStructBindingsRef Bindings = MakeShared<FStructBindings, ESPMode::ThreadSafe>();
+#if WITH_EDITOR
+		Bindings->ChildProperties = Struct->ChildProperties;
+#endif
+		Bindings->Fields.Reserve(MsgDef.FieldCount());
+		for (FFieldDefPtr FieldDef : MsgDef.Fields())
+		{
+			auto Prop = FindPropertyByField(Struct, FieldDef);
+			Bindings->Fields.Add(FFieldBinding{FieldDef, Prop, Prop ? Prop->GetOffset_ForInternal() : INDEX_NONE});
+		}
+
+		FRWScopeLock Lock(BindingsMap.Lock, SLT_Write);
+		if (auto Find = BindingsMap.Map.Find(Key))
+		{
+			// another thread may have published the same plan meanwhile
+			if (IsCurrent(**Find))
+				return *Find;
+			*Find = Bindings;
+		}
+		else
+		{
+			BindingsMap.Map.Add(Key, Bindings);
+		}
+		return Bindings;
+	}
+
 	int32 EncodeProtoImpl(FProtoWriter& Value, FProperty* Prop, const void* Addr);
 	int32 EncodeProtoImpl(FMessageDefPtr& MsgDef, FStructProperty* StructProp, const void* StructAddr, upb_Arena* Arena, upb_Message* MsgPtr = nullptr)
 	{
 		auto MsgRef = MsgPtr ? MsgPtr : upb_Message_New(MsgDef.MiniTable(), Arena);
 
 		int32 Ret = 0;
-		for (FFieldDefPtr FieldDef : MsgDef.Fields())
+		const FStructBindingsRef Bindings = FindOrAddStructBindings(MsgDef, StructProp->Struct);
+		for (const FFieldBinding& Binding : Bindings->Fields)
 		{
-			auto Prop = FindPropertyByField(StructProp->Struct, FieldDef);
 			// Should ensure struct always has the same field as proto?
-			if (ensureAlways(Prop))
+			if (ensureAlways(Binding.Prop))
 			{
-				FProtoWriter ValRef(FieldDef, MsgRef, Arena);
-				Ret += EncodeProtoImpl(ValRef, Prop, Prop->ContainerPtrToValuePtr<void>(StructAddr));
+				FProtoWriter ValRef(Binding.FieldDef, MsgRef, Arena);
+				Ret += EncodeProtoImpl(ValRef, Binding.Prop, static_cast<const uint8*>(StructAddr) + Binding.Offset);
 			}
 			else
 			{
-				GMP_ERROR(TEXT("Field %s not found in struct %s when encode proto"), *FieldDef.Name().ToFStringData(), *StructProp->GetName());
+				GMP_ERROR(TEXT("Field %s not found in struct %s when encode proto"), *Binding.FieldDef.Name().ToFStringData(), *StructProp->GetName());
 			}
 		}
 		return Ret;
@@ -962,17 +1185,17 @@ namespace Proto
 	int32 DecodeProtoImpl(const FMessageDefPtr& MsgDef, const upb_Message* MsgRef, FStructProperty* StructProp, void* StructAddr)
 	{
 		int32 Ret = 0;
-		for (FFieldDefPtr FieldDef : MsgDef.Fields())
+		const FStructBindingsRef Bindings = FindOrAddStructBindings(MsgDef, StructProp->Struct);
+		for (const FFieldBinding& Binding : Bindings->Fields)
 		{
-			auto Prop = FindPropertyByField(StructProp->Struct, FieldDef);
 			// Should ensure struct always has the same field as proto?
-			if (Prop)
+			if (Binding.Prop)
 			{
-				Ret += DecodeProtoImpl(FProtoReader(FieldDef, MsgRef), Prop, Prop->ContainerPtrToValuePtr<void>(StructAddr));
+				Ret += DecodeProtoImpl(FProtoReader(Binding.FieldDef, MsgRef), Binding.Prop, static_cast<uint8*>(StructAddr) + Binding.Offset);
 			}
 			else
 			{
-				GMP_WARNING(TEXT("Field %s not found in struct %s when decode proto"), *FieldDef.Name().ToFStringData(), *StructProp->GetName());
+				GMP_WARNING(TEXT("Field %s not found in struct %s when decode proto"), *Binding.FieldDef.Name().ToFStringData(), *StructProp->GetName());
 			}
 		}
 		return Ret;
@@ -999,7 +1222,7 @@ namespace Proto
 		}
 		bool UStructToProtoImpl(FArchive& Ar, const UScriptStruct* Struct, const void* StructAddr)
 		{
-			FArena Arena;
+			FPooledArena Arena;
 			char* OutBuf = nullptr;
 			size_t OutSize = 0;
 			auto Ret = UStructToProtoImpl(Struct, StructAddr, &OutBuf, &OutSize, Arena);
@@ -1043,7 +1266,7 @@ namespace Proto
 		{
 			if (auto MsgDef = FindMessageByStruct(Struct))
 			{
-				FDynamicArena Arena;
+				FPooledArena Arena;
 				upb_Message* MsgRef = upb_Message_New(MsgDef.MiniTable(), Arena);
 				upb_DecodeStatus Status = upb_Decode((const char*)In.GetData(), In.Num(), MsgRef, MsgDef.MiniTable(), nullptr, 0, Arena);
 				if (!ensureAlways(Status == upb_DecodeStatus::kUpb_DecodeStatus_Ok))
@@ -1067,6 +1290,899 @@ namespace Proto
 		}
 	}  // namespace Deserializer
 
+	//////////////////////////////////////////////////////////////////////////
+	// Streams the wire format straight between property memory and the byte buffer, no upb_Message in between
+	namespace Wire
+	{
+		static_assert(PLATFORM_LITTLE_ENDIAN, "fixed width values are copied as is");
+
+		enum EWireType : uint32
+		{
+			Varint = 0,
+			Fixed64 = 1,
+			Delimited = 2,
+			StartGroup = 3,
+			EndGroup = 4,
+			Fixed32 = 5,
+		};
+
+		static uint32 GetWireType(upb_FieldType Type)
+		{
+			switch (Type)
+			{
+				case kUpb_FieldType_Double:
+				case kUpb_FieldType_Fixed64:
+				case kUpb_FieldType_SFixed64:
+					return Fixed64;
+				case kUpb_FieldType_Float:
+				case kUpb_FieldType_Fixed32:
+				case kUpb_FieldType_SFixed32:
+					return Fixed32;
+				case kUpb_FieldType_String:
+				case kUpb_FieldType_Bytes:
+				case kUpb_FieldType_Message:
+					return Delimited;
+				case kUpb_FieldType_Group:
+					return StartGroup;
+				default:
+					return Varint;
+			}
+		}
+
+		struct FScalar
+		{
+			int64 Int = 0;
+			double Float = 0.0;
+			bool bFloat = false;
+
+			int64 AsInt() const { return bFloat ? (int64)Float : Int; }
+			double AsFloat() const { return bFloat ? Float : (double)Int; }
+		};
+
+		static FScalar LoadScalar(FProperty* Prop, const void* Addr)
+		{
+			FScalar Ret;
+			if (auto BoolProp = CastField<FBoolProperty>(Prop))
+			{
+				Ret.Int = BoolProp->GetPropertyValue(Addr) ? 1 : 0;
+			}
+			else if (auto EnumProp = CastField<FEnumProperty>(Prop))
+			{
+				Ret.Int = EnumProp->GetUnderlyingProperty()->GetSignedIntPropertyValue(Addr);
+			}
+			else if (auto NumProp = CastField<FNumericProperty>(Prop))
+			{
+				if (NumProp->IsFloatingPoint())
+				{
+					Ret.Float = NumProp->GetFloatingPointPropertyValue(Addr);
+					Ret.bFloat = true;
+				}
+				else if (NumProp->IsA<FUInt64Property>())
+				{
+					Ret.Int = (int64)NumProp->GetUnsignedIntPropertyValue(Addr);
+				}
+				else
+				{
+					Ret.Int = NumProp->GetSignedIntPropertyValue(Addr);
+				}
+			}
+			return Ret;
+		}
+
+		static void StoreScalar(FProperty* Prop, void* Addr, const FScalar& In)
+		{
+			if (auto BoolProp = CastField<FBoolProperty>(Prop))
+			{
+				BoolProp->SetPropertyValue(Addr, In.bFloat ? In.Float != 0.0 : In.Int != 0);
+			}
+			else if (auto EnumProp = CastField<FEnumProperty>(Prop))
+			{
+				EnumProp->GetUnderlyingProperty()->SetIntPropertyValue(Addr, In.AsInt());
+			}
+			else if (auto NumProp = CastField<FNumericProperty>(Prop))
+			{
+				if (NumProp->IsFloatingPoint())
+					NumProp->SetFloatingPointPropertyValue(Addr, In.AsFloat());
+				else if (NumProp->IsA<FUInt64Property>())
+					NumProp->SetIntPropertyValue(Addr, (uint64)In.AsInt());
+				else
+					NumProp->SetIntPropertyValue(Addr, In.AsInt());
+			}
+		}
+
+		// the raw bits as they go on the wire, zero means default for every scalar type
+		static uint64 ToWireBits(upb_FieldType Type, const FScalar& In)
+		{
+			switch (Type)
+			{
+				case kUpb_FieldType_Double:
+				{
+					const double Val = In.AsFloat();
+					uint64 Bits;
+					FMemory::Memcpy(&Bits, &Val, sizeof(Bits));
+					return Bits;
+				}
+				case kUpb_FieldType_Float:
+				{
+					const float Val = (float)In.AsFloat();
+					uint32 Bits;
+					FMemory::Memcpy(&Bits, &Val, sizeof(Bits));
+					return Bits;
+				}
+				case kUpb_FieldType_Bool:
+					return In.bFloat ? In.Float != 0.0 : In.Int != 0;
+				case kUpb_FieldType_SInt32:
+				{
+					const int32 Val = (int32)In.AsInt();
+					return (uint32)(((uint32)Val << 1) ^ (uint32)(Val >> 31));
+				}
+				case kUpb_FieldType_SInt64:
+				{
+					const int64 Val = In.AsInt();
+					return ((uint64)Val << 1) ^ (uint64)(Val >> 63);
+				}
+				case kUpb_FieldType_UInt32:
+				case kUpb_FieldType_Fixed32:
+				case kUpb_FieldType_SFixed32:
+					return (uint32)In.AsInt();
+				case kUpb_FieldType_Int32:
+				case kUpb_FieldType_Enum:
+					// negative values are sign extended to ten bytes like every other encoder does
+					return (uint64)(int64)(int32)In.AsInt();
+				default:
+					return (uint64)In.AsInt();
+			}
+		}
+
+		static FScalar FromWireBits(upb_FieldType Type, uint64 Bits)
+		{
+			FScalar Ret;
+			switch (Type)
+			{
+				case kUpb_FieldType_Double:
+					FMemory::Memcpy(&Ret.Float, &Bits, sizeof(Ret.Float));
+					Ret.bFloat = true;
+					break;
+				case kUpb_FieldType_Float:
+				{
+					const uint32 Bits32 = (uint32)Bits;
+					float Val;
+					FMemory::Memcpy(&Val, &Bits32, sizeof(Val));
+					Ret.Float = Val;
+					Ret.bFloat = true;
+					break;
+				}
+				case kUpb_FieldType_Bool:
+					Ret.Int = Bits != 0;
+					break;
+				case kUpb_FieldType_SInt32:
+				{
+					const uint32 Bits32 = (uint32)Bits;
+					Ret.Int = (int32)((Bits32 >> 1) ^ (0u - (Bits32 & 1u)));
+					break;
+				}
+				case kUpb_FieldType_SInt64:
+					Ret.Int = (int64)((Bits >> 1) ^ (0ull - (Bits & 1ull)));
+					break;
+				case kUpb_FieldType_UInt32:
+				case kUpb_FieldType_Fixed32:
+					Ret.Int = (uint32)Bits;
+					break;
+				case kUpb_FieldType_Int32:
+				case kUpb_FieldType_Enum:
+				case kUpb_FieldType_SFixed32:
+					Ret.Int = (int32)(uint32)Bits;
+					break;
+				default:
+					Ret.Int = (int64)Bits;
+					break;
+			}
+			return Ret;
+		}
+
+		static bool IsScalarProp(FProperty* Prop) { return Prop->IsA<FNumericProperty>() || Prop->IsA<FBoolProperty>() || Prop->IsA<FEnumProperty>(); }
+		static bool IsStringProp(FProperty* Prop) { return Prop->IsA<FStrProperty>() || Prop->IsA<FNameProperty>() || Prop->IsA<FTextProperty>(); }
+		static bool IsBytesProp(FProperty* Prop)
+		{
+			auto ArrProp = CastField<FArrayProperty>(Prop);
+			return ArrProp && (ArrProp->Inner->IsA<FByteProperty>() || ArrProp->Inner->IsA<FInt8Property>());
+		}
+
+		static bool IsStructReady(const FMessageDefPtr& MsgDef, const UScriptStruct* Struct);
+		static bool IsValueReady(FFieldDefPtr FieldDef, FProperty* Prop)
+		{
+			if (!Prop || Prop->ArrayDim != 1)
+				return false;
+
+			switch (FieldDef.GetType())
+			{
+				case kUpb_FieldType_Group:
+					return false;
+				case kUpb_FieldType_String:
+					return IsStringProp(Prop);
+				case kUpb_FieldType_Bytes:
+					return IsStringProp(Prop) || IsBytesProp(Prop);
+				case kUpb_FieldType_Message:
+				{
+					auto StructProp = CastField<FStructProperty>(Prop);
+#if WITH_GMPVALUE_ONEOF
+					if (StructProp && StructProp->Struct == FGMPValueOneOf::StaticStruct())
+						return false;
+#endif
+					return StructProp && IsStructReady(FieldDef.MessageSubdef(), StructProp->Struct);
+				}
+				default:
+					return IsScalarProp(Prop);
+			}
+		}
+		static bool IsFieldReady(FFieldDefPtr FieldDef, FProperty* Prop)
+		{
+			if (FieldDef.IsMap())
+			{
+				auto MapProp = CastField<FMapProperty>(Prop);
+				auto EntryDef = FieldDef.MapEntrySubdef();
+				return MapProp && MapProp->ArrayDim == 1 && IsValueReady(EntryDef.MapKeyDef(), MapProp->KeyProp) && IsValueReady(EntryDef.MapValueDef(), MapProp->ValueProp);
+			}
+			if (FieldDef.IsArray())
+			{
+				auto ArrProp = CastField<FArrayProperty>(Prop);
+				return ArrProp && ArrProp->ArrayDim == 1 && IsValueReady(FieldDef, ArrProp->Inner);
+			}
+			return IsValueReady(FieldDef, Prop);
+		}
+
+		// oneofs, groups, FGMPValueOneOf, sets and objects stay on the upb_Message path
+		static bool IsStructReady(const FMessageDefPtr& MsgDef, const UScriptStruct* Struct)
+		{
+			const FStructBindingsRef Entry = FindOrAddStructBindings(MsgDef, Struct);
+			const int8 State = Entry->WireState;
+			if (State != INDEX_NONE)
+				return !!State;
+
+			// optimistic for recursive structs, racing threads compute the same answer
+			Entry->WireState = 1;
+			const TArray<FFieldBinding>& Fields = Entry->Fields;
+			bool bReady = MsgDef.RealOneofCount() == 0;
+			for (int32 Idx = 0; bReady && Idx < Fields.Num(); ++Idx)
+				bReady = IsFieldReady(Fields[Idx].FieldDef, Fields[Idx].Prop);
+
+			Entry->WireState = bReady ? 1 : 0;
+			return bReady;
+		}
+
+		struct FWireWriter
+		{
+			TArray<uint8>& Buf;
+			explicit FWireWriter(TArray<uint8>& InBuf)
+				: Buf(InBuf)
+			{
+			}
+
+			static int32 EncodeVarint(uint8* Out, uint64 Val)
+			{
+				int32 Len = 0;
+				do
+				{
+					const uint8 Byte = Val & 0x7f;
+					Val >>= 7;
+					Out[Len++] = Val ? (Byte | 0x80) : Byte;
+				} while (Val);
+				return Len;
+			}
+			void WriteVarint(uint64 Val)
+			{
+				uint8 Tmp[10];
+				Buf.Append(Tmp, EncodeVarint(Tmp, Val));
+			}
+			void WriteTag(uint32 Number, uint32 WireType) { WriteVarint((Number << 3) | WireType); }
+			void WriteRaw(const void* Data, int32 Size) { Buf.Append(static_cast<const uint8*>(Data), Size); }
+			void WriteBits(upb_FieldType Type, uint64 Bits)
+			{
+				switch (GetWireType(Type))
+				{
+					case Fixed64:
+						WriteRaw(&Bits, sizeof(uint64));
+						break;
+					case Fixed32:
+					{
+						const uint32 Bits32 = (uint32)Bits;
+						WriteRaw(&Bits32, sizeof(uint32));
+						break;
+					}
+					default:
+						WriteVarint(Bits);
+						break;
+				}
+			}
+			void WriteString(const FString& Str)
+			{
+				const int32 Size = FTCHARToUTF8_Convert::ConvertedLength(*Str, Str.Len());
+				WriteVarint(Size);
+				const int32 Start = Buf.AddUninitialized(Size);
+				FTCHARToUTF8_Convert::Convert((char*)Buf.GetData() + Start, Size, *Str, Str.Len());
+			}
+
+			// reserve one byte for the length and widen it in place once the payload is known
+			int32 BeginDelimited()
+			{
+				Buf.AddUninitialized(1);
+				return Buf.Num();
+			}
+			void EndDelimited(int32 Start)
+			{
+				uint8 Tmp[10];
+				const int32 Len = EncodeVarint(Tmp, Buf.Num() - Start);
+				if (Len > 1)
+					Buf.InsertUninitialized(Start, Len - 1);
+				FMemory::Memcpy(Buf.GetData() + Start - 1, Tmp, Len);
+			}
+
+			void WriteValue(FFieldDefPtr FieldDef, FProperty* Prop, const void* Addr, bool bAlways)
+			{
+				const uint32 Number = FieldDef.Number();
+				const upb_FieldType Type = FieldDef.GetType();
+				switch (Type)
+				{
+					case kUpb_FieldType_Message:
+					{
+						WriteTag(Number, Delimited);
+						const int32 Start = BeginDelimited();
+						WriteStruct(FieldDef.MessageSubdef(), CastFieldChecked<FStructProperty>(Prop)->Struct, Addr);
+						EndDelimited(Start);
+						break;
+					}
+					case kUpb_FieldType_String:
+					case kUpb_FieldType_Bytes:
+					{
+						if (auto ArrProp = CastField<FArrayProperty>(Prop))
+						{
+							FScriptArrayHelper Helper(ArrProp, Addr);
+							if (bAlways || Helper.Num() > 0)
+							{
+								WriteTag(Number, Delimited);
+								WriteVarint(Helper.Num());
+								WriteRaw(Helper.GetRawPtr(), Helper.Num());
+							}
+						}
+						else
+						{
+							FString Temp;
+							const FString* Str = &Temp;
+							if (CastField<FStrProperty>(Prop))
+								Str = static_cast<const FString*>(Addr);
+							else if (CastField<FNameProperty>(Prop))
+								Temp = static_cast<const FName*>(Addr)->ToString();
+							else
+								Temp = static_cast<const FText*>(Addr)->ToString();
+
+							if (bAlways || !Str->IsEmpty())
+							{
+								WriteTag(Number, Delimited);
+								WriteString(*Str);
+							}
+						}
+						break;
+					}
+					default:
+					{
+						const uint64 Bits = ToWireBits(Type, LoadScalar(Prop, Addr));
+						if (bAlways || Bits)
+						{
+							WriteTag(Number, GetWireType(Type));
+							WriteBits(Type, Bits);
+						}
+						break;
+					}
+				}
+			}
+
+			void WriteField(FFieldDefPtr FieldDef, FProperty* Prop, const void* Addr)
+			{
+				if (FieldDef.IsMap())
+				{
+					auto MapProp = CastFieldChecked<FMapProperty>(Prop);
+					auto EntryDef = FieldDef.MapEntrySubdef();
+					const FFieldDefPtr KeyDef = EntryDef.MapKeyDef();
+					const FFieldDefPtr ValueDef = EntryDef.MapValueDef();
+					FScriptMapHelper Helper(MapProp, Addr);
+					for (int32 Idx = 0; Idx < Helper.GetMaxIndex(); ++Idx)
+					{
+						if (!Helper.IsValidIndex(Idx))
+							continue;
+						WriteTag(FieldDef.Number(), Delimited);
+						const int32 Start = BeginDelimited();
+						WriteValue(KeyDef, MapProp->KeyProp, Helper.GetKeyPtr(Idx), true);
+						WriteValue(ValueDef, MapProp->ValueProp, Helper.GetValuePtr(Idx), true);
+						EndDelimited(Start);
+					}
+				}
+				else if (FieldDef.IsArray())
+				{
+					auto ArrProp = CastFieldChecked<FArrayProperty>(Prop);
+					FScriptArrayHelper Helper(ArrProp, Addr);
+					if (Helper.Num() == 0)
+						return;
+
+					if (FieldDef.IsPacked())
+					{
+						const upb_FieldType Type = FieldDef.GetType();
+						WriteTag(FieldDef.Number(), Delimited);
+						const int32 Start = BeginDelimited();
+						for (int32 Idx = 0; Idx < Helper.Num(); ++Idx)
+							WriteBits(Type, ToWireBits(Type, LoadScalar(ArrProp->Inner, Helper.GetRawPtr(Idx))));
+						EndDelimited(Start);
+					}
+					else
+					{
+						for (int32 Idx = 0; Idx < Helper.Num(); ++Idx)
+							WriteValue(FieldDef, ArrProp->Inner, Helper.GetRawPtr(Idx), true);
+					}
+				}
+				else
+				{
+					// implicit presence fields skip their default value just like upb_Encode
+					WriteValue(FieldDef, Prop, Addr, FieldDef.HasPresence());
+				}
+			}
+
+			void WriteStruct(const FMessageDefPtr& MsgDef, const UScriptStruct* Struct, const void* StructAddr)
+			{
+				const FStructBindingsRef Bindings = FindOrAddStructBindings(MsgDef, Struct);
+				for (const FFieldBinding& Binding : Bindings->Fields)
+					WriteField(Binding.FieldDef, Binding.Prop, static_cast<const uint8*>(StructAddr) + Binding.Offset);
+			}
+		};
+
+		// same as the default decode depth limit of upb, deeper payloads fail instead of exhausting the stack
+		static constexpr int32 WireDepthLimit = 100;
+
+		struct FWireReader
+		{
+			const uint8* Ptr = nullptr;
+			const uint8* End = nullptr;
+			// nesting of this reader, every delimited sub reader is one deeper
+			int32 Depth = 0;
+
+			bool ReadVarint(uint64& Out)
+			{
+				Out = 0;
+				for (int32 Shift = 0; Shift < 64 && Ptr < End; Shift += 7)
+				{
+					const uint8 Byte = *Ptr++;
+					Out |= uint64(Byte & 0x7f) << Shift;
+					if (!(Byte & 0x80))
+						return true;
+				}
+				return false;
+			}
+			bool ReadRaw(void* Out, int32 Size)
+			{
+				if (End - Ptr < Size)
+					return false;
+				FMemory::Memcpy(Out, Ptr, Size);
+				Ptr += Size;
+				return true;
+			}
+			bool ReadDelimited(FWireReader& Out)
+			{
+				uint64 Len = 0;
+				if (!ReadVarint(Len) || Len > uint64(End - Ptr))
+					return false;
+				Out.Ptr = Ptr;
+				Out.End = Ptr + Len;
+				Out.Depth = Depth + 1;
+				Ptr = Out.End;
+				return true;
+			}
+			bool ReadBits(uint32 WireType, uint64& Bits)
+			{
+				switch (WireType)
+				{
+					case Varint:
+						return ReadVarint(Bits);
+					case Fixed64:
+						return ReadRaw(&Bits, sizeof(uint64));
+					case Fixed32:
+					{
+						uint32 Bits32 = 0;
+						const bool bOk = ReadRaw(&Bits32, sizeof(uint32));
+						Bits = Bits32;
+						return bOk;
+					}
+					default:
+						return false;
+				}
+			}
+			bool Skip(uint32 WireType)
+			{
+				uint64 Bits = 0;
+				FWireReader Unused;
+				return WireType == Delimited ? ReadDelimited(Unused) : ReadBits(WireType, Bits);
+			}
+
+			// a singular message seen again is merged into the previous one, as upb_Decode does
+			bool ReadValue(FFieldDefPtr FieldDef, FProperty* Prop, void* Addr, uint32 WireType, bool bMerge = false)
+			{
+				const upb_FieldType Type = FieldDef.GetType();
+				if (WireType != GetWireType(Type))
+					return false;
+
+				switch (Type)
+				{
+					case kUpb_FieldType_Message:
+					{
+						FWireReader Sub;
+						return ReadDelimited(Sub) && Sub.ReadStruct(FieldDef.MessageSubdef(), CastFieldChecked<FStructProperty>(Prop)->Struct, Addr, bMerge);
+					}
+					case kUpb_FieldType_String:
+					case kUpb_FieldType_Bytes:
+					{
+						FWireReader Str;
+						if (!ReadDelimited(Str))
+							return false;
+
+						const auto Len = Str.End - Str.Ptr;
+						if (auto ArrProp = CastField<FArrayProperty>(Prop))
+						{
+							FScriptArrayHelper Helper(ArrProp, Addr);
+							Helper.Resize((int32)Len);
+							if (Len)
+								FMemory::Memcpy(Helper.GetRawPtr(), Str.Ptr, Len);
+						}
+						else if (CastField<FStrProperty>(Prop))
+						{
+							*static_cast<FString*>(Addr) = StringView((const char*)Str.Ptr, Len).ToFString();
+						}
+						else if (CastField<FNameProperty>(Prop))
+						{
+							*static_cast<FName*>(Addr) = StringView((const char*)Str.Ptr, Len).ToFName(FNAME_Add);
+						}
+						else
+						{
+							*static_cast<FText*>(Addr) = FText::FromString(StringView((const char*)Str.Ptr, Len).ToFString());
+						}
+						return true;
+					}
+					default:
+					{
+						uint64 Bits = 0;
+						if (!ReadBits(WireType, Bits))
+							return false;
+						StoreScalar(Prop, Addr, FromWireBits(Type, Bits));
+						return true;
+					}
+				}
+			}
+
+			bool ReadMapEntry(const FMessageDefPtr& EntryDef, FMapProperty* MapProp, void* KeyAddr, void* ValueAddr)
+			{
+				while (Ptr < End)
+				{
+					uint64 Tag = 0;
+					if (!ReadVarint(Tag))
+						return false;
+					const uint32 WireType = uint32(Tag & 7);
+					const uint64 Number = Tag >> 3;
+					const bool bOk = Number == 1 ? ReadValue(EntryDef.MapKeyDef(), MapProp->KeyProp, KeyAddr, WireType)
+								   : Number == 2 ? ReadValue(EntryDef.MapValueDef(), MapProp->ValueProp, ValueAddr, WireType)
+												 : Skip(WireType);
+					if (!bOk)
+						return false;
+				}
+				return true;
+			}
+
+			bool ReadField(FFieldDefPtr FieldDef, FProperty* Prop, void* Addr, uint32 WireType, bool bFirst)
+			{
+				if (FieldDef.IsMap())
+				{
+					FWireReader Entry;
+					if (WireType != Delimited || !ReadDelimited(Entry))
+						return false;
+
+					auto MapProp = CastFieldChecked<FMapProperty>(Prop);
+					FScriptMapHelper Helper(MapProp, Addr);
+					if (bFirst)
+						Helper.EmptyValues();
+
+					// keys may repeat on the wire and the last entry wins, so entries are decoded aside and then added by key
+					FMemory_Alloca_Prop_Assign(KeyAddr, MapProp->KeyProp);
+					FMemory_Alloca_Prop_Assign(ValueAddr, MapProp->ValueProp);
+					MapProp->KeyProp->InitializeValue(KeyAddr);
+					MapProp->ValueProp->InitializeValue(ValueAddr);
+					const bool bOk = Entry.ReadMapEntry(FieldDef.MapEntrySubdef(), MapProp, KeyAddr, ValueAddr);
+					if (bOk)
+						Helper.AddPair(KeyAddr, ValueAddr);
+					MapProp->KeyProp->DestroyValue(KeyAddr);
+					MapProp->ValueProp->DestroyValue(ValueAddr);
+					return bOk;
+				}
+				if (FieldDef.IsArray())
+				{
+					auto ArrProp = CastFieldChecked<FArrayProperty>(Prop);
+					FScriptArrayHelper Helper(ArrProp, Addr);
+					if (bFirst)
+						Helper.EmptyValues();
+
+					// packed and unpacked scalars are both accepted whatever the field says
+					const upb_FieldType Type = FieldDef.GetType();
+					const uint32 ElmWireType = GetWireType(Type);
+					if (WireType == Delimited && ElmWireType != Delimited)
+					{
+						FWireReader Packed;
+						if (!ReadDelimited(Packed))
+							return false;
+						while (Packed.Ptr < Packed.End)
+						{
+							uint64 Bits = 0;
+							if (!Packed.ReadBits(ElmWireType, Bits))
+								return false;
+							StoreScalar(ArrProp->Inner, Helper.GetRawPtr(Helper.AddValue()), FromWireBits(Type, Bits));
+						}
+						return true;
+					}
+					return ReadValue(FieldDef, ArrProp->Inner, Helper.GetRawPtr(Helper.AddValue()), WireType);
+				}
+				return ReadValue(FieldDef, Prop, Addr, WireType, !bFirst);
+			}
+
+			// when merging, repeated fields append and absent fields keep their current value
+			bool ReadStruct(const FMessageDefPtr& MsgDef, const UScriptStruct* Struct, void* StructAddr, bool bMerge = false)
+			{
+				if (Depth > WireDepthLimit)
+				{
+					GMP_WARNING(TEXT("proto data for %s nests deeper than %d"), *Struct->GetName(), WireDepthLimit);
+					return false;
+				}
+
+				const FStructBindingsRef Bindings = FindOrAddStructBindings(MsgDef, Struct);
+				const TArray<FFieldBinding>& Fields = Bindings->Fields;
+				TArray<bool, TInlineAllocator<32>> Touched;
+				Touched.SetNumZeroed(Fields.Num());
+				bool bOk = true;
+				while (bOk && Ptr < End)
+				{
+					uint64 Tag = 0;
+					if (!ReadVarint(Tag))
+					{
+						bOk = false;
+						break;
+					}
+
+					const uint32 WireType = uint32(Tag & 7);
+					FFieldDefPtr FieldDef = MsgDef.FindFieldByNumber(uint32(Tag >> 3));
+					if (!FieldDef)
+					{
+						bOk = Skip(WireType);
+						continue;
+					}
+
+					const int32 Idx = FieldDef.Index();
+					const FFieldBinding& Binding = Fields[Idx];
+					bOk = ReadField(Binding.FieldDef, Binding.Prop, static_cast<uint8*>(StructAddr) + Binding.Offset, WireType, !bMerge && !Touched[Idx]);
+					Touched[Idx] = true;
+				}
+
+				if (bOk && !bMerge)
+				{
+					// absent fields read back as their defaults, same as decoding through upb_Message
+					for (int32 Idx = 0; Idx < Fields.Num(); ++Idx)
+					{
+						if (!Touched[Idx])
+							Fields[Idx].Prop->ClearValue(static_cast<uint8*>(StructAddr) + Fields[Idx].Offset);
+					}
+				}
+				return bOk;
+			}
+		};
+	}  // namespace Wire
+
+	namespace Serializer
+	{
+		bool UStructToProtoWireImpl(TArray<uint8>& Out, const UScriptStruct* Struct, const void* StructAddr)
+		{
+			auto MsgDef = FindMessageByStruct(Struct);
+			if (!MsgDef)
+			{
+				GMP_WARNING(TEXT("Message %s not found"), *Struct->GetName());
+				return false;
+			}
+			// the fallback writes from offset 0 too, stale trailing bytes would decode as extra fields
+			Out.Reset();
+			if (!Wire::IsStructReady(MsgDef, Struct))
+				return UStructToProtoImpl(Out, Struct, StructAddr);
+
+			Wire::FWireWriter(Out).WriteStruct(MsgDef, Struct, StructAddr);
+			return true;
+		}
+	}  // namespace Serializer
+
+	namespace Deserializer
+	{
+		bool UStructFromProtoWireImpl(TConstArrayView<uint8> In, const UScriptStruct* Struct, void* StructAddr)
+		{
+			auto MsgDef = FindMessageByStruct(Struct);
+			if (!MsgDef)
+			{
+				GMP_WARNING(TEXT("Message %s not found"), *Struct->GetName());
+				return false;
+			}
+			if (!Wire::IsStructReady(MsgDef, Struct))
+				return UStructFromProtoImpl(In, Struct, StructAddr);
+
+			Wire::FWireReader Reader{In.GetData(), In.GetData() + In.Num()};
+			// the input comes from the network or disk, malformed data is not a programming error
+			if (!Reader.ReadStruct(MsgDef, Struct, StructAddr))
+			{
+				GMP_WARNING(TEXT("malformed proto data for %s"), *Struct->GetName());
+				return false;
+			}
+			return true;
+		}
+	}  // namespace Deserializer
+
+#if !UE_BUILD_SHIPPING
+	// non default values everywhere, so implicit presence fields are not skipped and containers are not empty
+	static void FillBenchValue(FProperty* Prop, void* Addr, int32 Seed, int32 Depth);
+	static void FillBenchStruct(const UScriptStruct* Struct, void* StructAddr, int32 Seed, int32 Depth)
+	{
+		int32 Offset = 0;
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			for (int32 ArrIdx = 0; ArrIdx < It->ArrayDim; ++ArrIdx)
+				FillBenchValue(*It, It->ContainerPtrToValuePtr<void>(StructAddr, ArrIdx), Seed + ++Offset, Depth);
+		}
+	}
+	static void FillBenchValue(FProperty* Prop, void* Addr, int32 Seed, int32 Depth)
+	{
+		auto FillInteger = [](FNumericProperty* NumProp, UEnum* Enum, void* InAddr, int32 InSeed) {
+			const int32 NumEnums = Enum ? Enum->NumEnums() - 1 : 0;
+			NumProp->SetIntPropertyValue(InAddr, NumEnums > 0 ? Enum->GetValueByIndex(InSeed % NumEnums) : int64(InSeed));
+		};
+
+		if (auto EnumProp = CastField<FEnumProperty>(Prop))
+		{
+			FillInteger(EnumProp->GetUnderlyingProperty(), EnumProp->GetEnum(), Addr, Seed);
+		}
+		else if (auto NumProp = CastField<FNumericProperty>(Prop))
+		{
+			if (NumProp->IsFloatingPoint())
+				NumProp->SetFloatingPointPropertyValue(Addr, Seed * 1.5);
+			else
+				FillInteger(NumProp, NumProp->GetIntPropertyEnum(), Addr, Seed);
+		}
+		else if (auto BoolProp = CastField<FBoolProperty>(Prop))
+		{
+			BoolProp->SetPropertyValue(Addr, (Seed & 1) != 0);
+		}
+		else if (CastField<FStrProperty>(Prop))
+		{
+			*static_cast<FString*>(Addr) = FString::Printf(TEXT("gmp_bench_%d"), Seed);
+		}
+		else if (CastField<FNameProperty>(Prop))
+		{
+			*static_cast<FName*>(Addr) = FName(TEXT("gmp_bench"), Seed);
+		}
+		else if (CastField<FTextProperty>(Prop))
+		{
+			*static_cast<FText*>(Addr) = FText::FromString(FString::Printf(TEXT("gmp_bench_%d"), Seed));
+		}
+		else if (auto StructProp = CastField<FStructProperty>(Prop))
+		{
+			if (Depth < 4)
+				FillBenchStruct(StructProp->Struct, Addr, Seed, Depth + 1);
+		}
+		else if (auto ArrProp = CastField<FArrayProperty>(Prop))
+		{
+			FScriptArrayHelper Helper(ArrProp, Addr);
+			Helper.Resize(4);
+			for (int32 Idx = 0; Idx < Helper.Num(); ++Idx)
+				FillBenchValue(ArrProp->Inner, Helper.GetRawPtr(Idx), Seed + Idx + 1, Depth);
+		}
+		else if (auto MapProp = CastField<FMapProperty>(Prop))
+		{
+			FScriptMapHelper Helper(MapProp, Addr);
+			FMemory_Alloca_Prop_Assign(KeyAddr, MapProp->KeyProp);
+			FMemory_Alloca_Prop_Assign(ValueAddr, MapProp->ValueProp);
+			for (int32 Idx = 0; Idx < 4; ++Idx)
+			{
+				MapProp->KeyProp->InitializeValue(KeyAddr);
+				MapProp->ValueProp->InitializeValue(ValueAddr);
+				FillBenchValue(MapProp->KeyProp, KeyAddr, Seed + Idx + 1, Depth);
+				FillBenchValue(MapProp->ValueProp, ValueAddr, Seed + Idx + 1, Depth);
+				Helper.AddPair(KeyAddr, ValueAddr);
+				MapProp->KeyProp->DestroyValue(KeyAddr);
+				MapProp->ValueProp->DestroyValue(ValueAddr);
+			}
+		}
+	}
+
+	static FXConsoleCommandLambda XVar_GMPBenchProtoWire(TEXT("gmp.bench.protoWire"), [](const FString& StructPath, int32 Count, UWorld* InWorld) {
+		auto Struct = LoadObject<UScriptStruct>(nullptr, *StructPath);
+		if (!Struct)
+		{
+			UE_LOG(LogGMP, Warning, TEXT("gmp.bench.protoWire : struct %s not found"), *StructPath);
+			return;
+		}
+		Count = Count > 0 ? Count : 10000;
+
+		FStructOnScope Src(Struct);
+		FStructOnScope Dst(Struct);
+		FillBenchStruct(Struct, Src.GetStructMemory(), 0, 0);
+		TArray<uint8> Buf;
+		auto Measure = [&](auto&& Func) {
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Idx = 0; Idx < Count; ++Idx)
+				Func();
+			return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		};
+
+		const double MsgEncode = Measure([&] { Serializer::UStructToProtoImpl(Buf, Struct, Src.GetStructMemory()); });
+		const int32 MsgBytes = Buf.Num();
+		const double MsgDecode = Measure([&] { Deserializer::UStructFromProtoImpl(Buf, Struct, Dst.GetStructMemory()); });
+
+		const double WireEncode = Measure([&] { Serializer::UStructToProtoWireImpl(Buf, Struct, Src.GetStructMemory()); });
+		const int32 WireBytes = Buf.Num();
+		const double WireDecode = Measure([&] { Deserializer::UStructFromProtoWireImpl(Buf, Struct, Dst.GetStructMemory()); });
+
+		const bool bDirect = Wire::IsStructReady(FindMessageByStruct(Struct), Struct);
+		const bool bRoundTrip = Struct->CompareScriptStruct(Src.GetStructMemory(), Dst.GetStructMemory(), PPF_None);
+		UE_LOG(LogGMP,
+			   Display,
+			   TEXT("gmp.bench.protoWire %s x%d : upb_Message encode %.3f ms decode %.3f ms (%d bytes), wire%s encode %.3f ms decode %.3f ms (%d bytes), round trip %s"),
+			   *Struct->GetName(),
+			   Count,
+			   MsgEncode,
+			   MsgDecode,
+			   MsgBytes,
+			   bDirect ? TEXT("") : TEXT(" (fallback)"),
+			   WireEncode,
+			   WireDecode,
+			   WireBytes,
+			   bRoundTrip ? TEXT("ok") : TEXT("MISMATCH"));
+	});
+
+	// feeds a payload nesting a self recursive message field past the depth limit, decoding must fail cleanly
+	static FXConsoleCommandLambda XVar_GMPTestProtoWireDepth(TEXT("gmp.test.protoWireDepth"), [](const FString& StructPath, UWorld* InWorld) {
+		auto Struct = LoadObject<UScriptStruct>(nullptr, *StructPath);
+		auto MsgDef = Struct ? FindMessageByStruct(Struct) : FMessageDefPtr();
+		if (!MsgDef)
+		{
+			UE_LOG(LogGMP, Warning, TEXT("gmp.test.protoWireDepth : message of %s not found"), *StructPath);
+			return;
+		}
+
+		uint32 Number = 0;
+		for (FFieldDefPtr FieldDef : MsgDef.Fields())
+		{
+			if (FieldDef.GetType() == kUpb_FieldType_Message && *FieldDef.MessageSubdef() == *MsgDef)
+			{
+				Number = FieldDef.Number();
+				break;
+			}
+		}
+		if (!Number)
+		{
+			UE_LOG(LogGMP, Warning, TEXT("gmp.test.protoWireDepth : %s has no self recursive message field"), *Struct->GetName());
+			return;
+		}
+
+		TArray<uint8> Payload;
+		for (int32 Level = 0; Level < Wire::WireDepthLimit * 2; ++Level)
+		{
+			uint8 Head[20];
+			int32 HeadLen = Wire::FWireWriter::EncodeVarint(Head, (Number << 3) | Wire::Delimited);
+			HeadLen += Wire::FWireWriter::EncodeVarint(Head + HeadLen, Payload.Num());
+			Payload.Insert(Head, HeadLen, 0);
+		}
+
+		FStructOnScope Dst(Struct);
+		const bool bDecoded = Deserializer::UStructFromProtoWireImpl(Payload, Struct, Dst.GetStructMemory());
+		if (ensureMsgf(!bDecoded, TEXT("gmp.test.protoWireDepth : %d levels decoded"), Wire::WireDepthLimit * 2))
+			UE_LOG(LogGMP, Display, TEXT("gmp.test.protoWireDepth %s : %d levels (%d bytes) rejected"), *Struct->GetName(), Wire::WireDepthLimit * 2, Payload.Num());
+	});
+#endif
+
 	namespace Detail
 	{
 
@@ -12,6 +12,7 @@
 #include "Internationalization/Regex.h"
 #include "Misc/PackageName.h"
 #include "Misc/ScopeExit.h"
+#include "Misc/ScopeRWLock.h"
 #include "UObject/Interface.h"
 #include "UObject/ObjectKey.h"
 #include "UObject/TextProperty.h"
@@ -194,6 +195,27 @@ namespace Reflection
 	{
 		return PropertyStorage;
 	}
+
+	// type strings exactly as callers passed them --> resolved property
+	// kept apart from PropertyStorage so it can be probed from any thread
+	struct FResolvedProperties
+	{
+		FRWLock Lock;
+		TMap<FName, FProperty*> Props;
+
+		FProperty* Find(FName TypeName)
+		{
+			FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+			auto Find = Props.Find(TypeName);
+			return Find ? *Find : nullptr;
+		}
+		void Add(FName TypeName, FProperty* Prop)
+		{
+			FRWScopeLock ScopeLock(Lock, SLT_Write);
+			Props.Add(TypeName, Prop);
+		}
+	};
+	static FResolvedProperties ResolvedProperties;
 #if GMP_USE_NEW_PROP_FROM_STRING
 	static TMap<FName, FProperty* (*)()> BasePropertyStorageGen;
 	static auto& GenBaseProperty()
@@ -1708,9 +1730,14 @@ namespace Reflection
 
 	// clang-format off
 template<bool bUseNewProp>
-bool PropertyFromStringImpl(FString TypeString, FProperty*& OutProp, bool bInTemplate, bool bInContainer)
+bool PropertyFromStringImpl(const FString& InTypeString, FProperty*& OutProp, bool bInTemplate, bool bInContainer)
 {
-	TypeString = TypeString.Replace(TEXT(" "), TEXT(""), ESearchCase::CaseSensitive);
+	// only strip spaces when there are any, normalized names are used as is
+	const bool bHasSpace = InTypeString.Contains(TEXT(" "), ESearchCase::CaseSensitive);
+	FString Normalized;
+	if (bHasSpace)
+		Normalized = InTypeString.Replace(TEXT(" "), TEXT(""), ESearchCase::CaseSensitive);
+	const FString& TypeString = bHasSpace ? Normalized : InTypeString;
 	if (TypeString.Len() < 2)
 		return false;
 
@@ -1893,14 +1920,82 @@ bool PropertyFromStringImpl(FString TypeString, FProperty*& OutProp, bool bInTem
 }
 	// clang-format on
 
-	bool PropertyFromString(FString TypeString, FProperty*& OutProp, bool bInTemplate, bool bInContainer, bool bNew)
+	static bool IsStaleProperty(FProperty* Prop)
+	{
+#if WITH_EDITOR
+		if (GIsEditor)
+		{
+			if (auto StructProp = CastField<FStructProperty>(Prop))
+				return !StructProp->Struct || StructProp->Struct->HasAnyFlags(RF_NewerVersionExists);
+			if (auto EnumProp = CastField<FEnumProperty>(Prop))
+				return !EnumProp->GetEnum() || EnumProp->GetEnum()->HasAnyFlags(RF_NewerVersionExists);
+			if (auto ByteProp = CastField<FByteProperty>(Prop))
+				return ByteProp->GetIntPropertyEnum() && ByteProp->GetIntPropertyEnum()->HasAnyFlags(RF_NewerVersionExists);
+		}
+#endif
+		return false;
+	}
+
+	bool PropertyFromName(FName TypeName, FProperty*& OutProp)
 	{
-		return bNew ? PropertyFromStringImpl<true>(TypeString, OutProp, bInTemplate, bInContainer) : PropertyFromStringImpl<false>(TypeString, OutProp, bInTemplate, bInContainer);
+		FProperty* Prop = TypeName.IsNone() ? nullptr : Reflection::ResolvedProperties.Find(TypeName);
+		if (Prop && !IsStaleProperty(Prop))
+		{
+			OutProp = Prop;
+			return true;
+		}
+		return PropertyFromString(TypeName.ToString(), OutProp);
+	}
+
+	UField* PropertyTypeObject(const FProperty* Prop)
+	{
+		if (auto ArrProp = CastField<FArrayProperty>(Prop))
+			return PropertyTypeObject(ArrProp->Inner);
+		if (auto SetProp = CastField<FSetProperty>(Prop))
+			return PropertyTypeObject(SetProp->ElementProp);
+		if (auto MapProp = CastField<FMapProperty>(Prop))
+		{
+			auto ValueType = PropertyTypeObject(MapProp->ValueProp);
+			return ValueType ? ValueType : PropertyTypeObject(MapProp->KeyProp);
+		}
+		if (auto StructProp = CastField<FStructProperty>(Prop))
+			return StructProp->Struct;
+		if (auto ObjProp = CastField<FObjectPropertyBase>(Prop))
+			return ObjProp->PropertyClass;
+		if (auto EnumProp = CastField<FEnumProperty>(Prop))
+			return EnumProp->GetEnum();
+		if (auto ByteProp = CastField<FByteProperty>(Prop))
+			return ByteProp->GetIntPropertyEnum();
+		return nullptr;
+	}
+
+	bool PropertyFromString(const FString& TypeString, FProperty*& OutProp, bool bInTemplate, bool bInContainer, bool bNew)
+	{
+		// resolving creates properties and writes PropertyStorage, only hits of ResolvedProperties are thread safe
+		auto CanResolve = [&] { return ensureAlwaysMsgf(IsInGameThread(), TEXT("PropertyFromString(%s) must be resolved on the game thread first"), *TypeString); };
+		if (bNew)
+			return CanResolve() && PropertyFromStringImpl<true>(TypeString, OutProp, bInTemplate, bInContainer);
+
+		// FNAME_Find never adds to the name table, unknown strings simply miss
+		const FName TypeName(*TypeString, FNAME_Find);
+		FProperty* Prop = TypeName.IsNone() ? nullptr : Reflection::ResolvedProperties.Find(TypeName);
+		if (Prop && !IsStaleProperty(Prop))
+		{
+			OutProp = Prop;
+			return true;
+		}
+
+		if (!CanResolve() || !PropertyFromStringImpl<false>(TypeString, OutProp, bInTemplate, bInContainer))
+			return false;
+		Reflection::ResolvedProperties.Add(TypeName.IsNone() ? FName(*TypeString) : TypeName, OutProp);
+		return true;
 	}
 
 #if GMP_USE_NEW_PROP_FROM_STRING
-	bool NewPropertyFromString(FString TypeString, FProperty*& OutProp, bool bInTemplate, bool bInContainer)
+	bool NewPropertyFromString(const FString& TypeString, FProperty*& OutProp, bool bInTemplate, bool bInContainer)
 	{
+		if (!ensureAlways(IsInGameThread()))
+			return false;
 		return PropertyFromStringImpl<true>(TypeString, OutProp, bInTemplate, bInContainer);
 	}
 #endif
@@ -19,6 +19,7 @@
 #include "UObject/PropertyPortFlags.h"
 #include "UObject/UObjectGlobals.h"
 #include "UnrealCompatibility.h"
+#include "XConsoleManager.h"
 
 #if UE_5_06_OR_LATER
 #include "Stats/Stats.h"
@@ -74,13 +75,121 @@ const TArray<FProperty*>* UGMPRpcValidation::Find(const UObject* Obj, const FNam
 	return GMPRpcProcessors(Obj).Find(MessageKey);
 }
 
+const FGMPRpcRecvPlan& UGMPRpcValidation::FindRecvPlan(const UObject* Obj, const FName& MessageKey, const TArray<FProperty*>& Props)
+{
+	auto& Plan = GMPRpcValidation(Obj).RecvPlans.FindOrAdd(MessageKey);
+	if (!Plan.IsValid())
+		Plan = MakeUnique<FGMPRpcRecvPlan>(FGMPRpcRecvPlan::Build(Props));
+	return *Plan;
+}
+
+FGMPRpcRecvPlan FGMPRpcRecvPlan::Build(const TArray<FProperty*>& Props)
+{
+	// numeric properties net serialize as their raw bytes, adjacent ones read as one copy
+	auto IsRawNumeric = [](FProperty* Prop) {
+		if (Prop->ArrayDim != 1)
+			return false;
+		if (auto ByteProp = CastField<FByteProperty>(Prop))
+			return !ByteProp->Enum;
+		return Prop->IsA<FNumericProperty>();
+	};
+
+	FGMPRpcRecvPlan Plan;
+	Plan.Offsets.Reserve(Props.Num());
+	for (int32 Idx = 0; Idx < Props.Num(); ++Idx)
+	{
+		FProperty* Prop = Props[Idx];
+		const int32 PropAlign = FMath::Max(Prop->GetMinAlignment(), 1);
+		const int32 Offset = Align(Plan.FrameSize, PropAlign);
+		const int32 Size = GMP::GetElementSize(Prop);
+		Plan.Offsets.Add(Offset);
+		Plan.FrameSize = Offset + Size;
+		Plan.FrameAlign = FMath::Max(Plan.FrameAlign, PropAlign);
+
+		const bool bRaw = IsRawNumeric(Prop);
+		if (!bRaw)
+			Plan.InitIndices.Add(Idx);
+		if (!Prop->HasAnyPropertyFlags(CPF_NoDestructor))
+			Plan.DestroyIndices.Add(Idx);
+
+		FStep* Last = Plan.Steps.Num() > 0 ? &Plan.Steps.Last() : nullptr;
+		if (bRaw && Last && Last->NumBytes > 0 && Last->Offset + Last->NumBytes == Offset)
+		{
+			Last->NumBytes += Size;
+		}
+		else
+		{
+			FStep& Step = Plan.Steps.AddDefaulted_GetRef();
+			Step.PropIndex = Idx;
+			Step.Offset = Offset;
+			Step.NumBytes = bRaw ? Size : 0;
+		}
+	}
+	return Plan;
+}
+
 int32 UGMPRpcValidation::GetNextPlayerSequence(const APlayerController& PC)
 {
 	return (++GMPRpcValidation(&PC).PlayerSequenceID);
 }
 
+namespace GMP
+{
+namespace RpcCoalesce
+{
+	static bool bEnabled = false;
+	FAutoConsoleVariableRef CVar_Coalesce(TEXT("gmp.rpc.coalesce"), bEnabled, TEXT("write all gmp rpcs of a connection in one frame into one stream, flushed after actor tick"));
+	static int32 UnreliableFrameBytes = 1024;
+	FAutoConsoleVariableRef CVar_UnreliableFrameBytes(TEXT("gmp.rpc.unreliableFrameBytes"), UnreliableFrameBytes, TEXT("unreliable bytes per connection and frame before droppable messages are discarded"));
+
+	static float DeltaFullInterval = 1.f;
+	FAutoConsoleVariableRef CVar_DeltaFullInterval(TEXT("gmp.rpc.deltaFullInterval"), DeltaFullInterval, TEXT("seconds between full snapshots of delta encoded unreliable messages"));
+
+	static TMap<FName, EGMPRpcUnreliablePolicy> Policies;
+	static TArray<TWeakObjectPtr<UGMPRpcProxy>> QueuedProxies;
+
+	// the changed mask is 32 bits wide
+	static bool UseDelta(FName Key, TArrayView<const int32> ArgBitEnds)
+	{
+		return ArgBitEnds.Num() > 0 && ArgBitEnds.Num() <= 32 && Policies.FindRef(Key) == EGMPRpcUnreliablePolicy::Delta;
+	}
+
+	template<typename MapType>
+	static void PruneDeltaStates(MapType& States)
+	{
+		for (auto It = States.CreateIterator(); It; ++It)
+		{
+			if (!It->Key.template Get<1>().ResolveObjectPtr())
+				It.RemoveCurrent();
+		}
+	}
+
+	struct FStats
+	{
+		int64 Queued = 0;
+		int64 Streams = 0;
+		int64 Superseded = 0;
+		int64 Dropped = 0;
+		int64 DeltaFull = 0;
+		int64 DeltaPartial = 0;
+		int64 DeltaUnchanged = 0;
+		int64 DeltaResync = 0;
+	};
+	static FStats Stats;
+
+#if !UE_BUILD_SHIPPING
+	FXConsoleCommandLambdaFull XVar_GMPRpcStats(TEXT("gmp.stats.rpc"), TEXT("gmp.stats.rpc"), [](UWorld* InWorld, FOutputDevice& Ar) {
+		Ar.Logf(TEXT("GMPRpc : coalesce %d, %lld queued, %lld streams, %lld superseded, %lld dropped"), bEnabled ? 1 : 0, Stats.Queued, Stats.Streams, Stats.Superseded, Stats.Dropped);
+		Ar.Logf(TEXT("GMPRpc delta : %lld full, %lld partial, %lld unchanged, %lld resync"), Stats.DeltaFull, Stats.DeltaPartial, Stats.DeltaUnchanged, Stats.DeltaResync);
+	});
+#endif
+}  // namespace RpcCoalesce
+}  // namespace GMP
+
 //////////////////////////////////////////////////////////////////////////
 const int32 UGMPRpcProxy::MaxByteCount = 1024;
+const int32 UGMPRpcProxy::MaxKeyCount = 4096;
+const int32 UGMPRpcProxy::MaxStreamByteCount = 16 * 1024;
 
 UGMPRpcProxy::UGMPRpcProxy()
 {
@@ -186,26 +295,84 @@ void UGMPRpcProxy::CallLocalFunction(UObject* InObject, FName InFunctionName, co
 	}
 }
 
-void UGMPRpcProxy::RPC_Request_Implementation(UObject* InObject, const FString& FuncName, const TArray<uint8>& Buffer)
+FGMPRpcKeyId UGMPRpcProxy::InternSendKey(FName Key)
+{
+	if (auto Find = SendKeyIds.Find(Key))
+		return FGMPRpcKeyId(*Find);
+
+	FGMPRpcKeyId KeyId(SendKeyIds.Num());
+	SendKeyIds.Add(Key, KeyId.Id);
+	// reliable rpcs stay ordered, so the definition arrives before any use except unreliable ones
+	if (GetNetMode() != NM_DedicatedServer)
+		Key_Define_Request(KeyId, Key.ToString());
+	else
+		Key_Define_Notify(KeyId, Key.ToString());
+	return KeyId;
+}
+
+bool UGMPRpcProxy::DefineRecvKey(FGMPRpcKeyId KeyId, const FString& Key)
+{
+	// only names the receiver already knows, in the order they were interned
+	FName KeyName(*Key, FNAME_Find);
+	if (KeyName.IsNone() || KeyId.Id != uint32(RecvKeys.Num()) || RecvKeys.Num() >= MaxKeyCount)
+		return false;
+	RecvKeys.Add(KeyName);
+	return true;
+}
+
+bool UGMPRpcProxy::Key_Define_Request_Validate(FGMPRpcKeyId KeyId, const FString& Key)
 {
-	CallLocalFunction(InObject, *FuncName, Buffer);
+	return ensureAlwaysMsgf(KeyId.Id == uint32(RecvKeys.Num()) && RecvKeys.Num() < MaxKeyCount, TEXT("Key_Define_Request_Validate : %u %s"), KeyId.Id, *Key);
 }
 
-bool UGMPRpcProxy::RPC_Request_Validate(UObject* InObject, const FString& FuncName, const TArray<uint8>& Buffer)
+void UGMPRpcProxy::Key_Define_Request_Implementation(FGMPRpcKeyId KeyId, const FString& Key)
 {
-	FName FunName(*FuncName, FNAME_Find);
-	UFunction* Func = (FunName.IsValid() && (Buffer.Num() <= MaxByteCount) && IsValid(InObject)) ? InObject->FindFunction(FunName) : nullptr;
-	if (!(Func && Func->HasAnyFunctionFlags(FUNC_NetRequest) && Buffer.Num() <= Func->ParmsSize))
+	if (!DefineRecvKey(KeyId, Key))
 	{
-		GMP_WARNING(TEXT("RPC_Request_Validate : %s in %s"), *FuncName, *GetNameSafe(InObject));
-		return ensure(false);
+		// keep the ids aligned, uses of an unknown name fail their own validation
+		RecvKeys.Add(NAME_None);
+	}
+}
+
+void UGMPRpcProxy::Key_Define_Notify_Implementation(FGMPRpcKeyId KeyId, const FString& Key)
+{
+	if (!DefineRecvKey(KeyId, Key))
+	{
+		GMP_WARNING(TEXT("Key_Define_Notify : unknown key %u %s"), KeyId.Id, *Key);
+		if (KeyId.Id == uint32(RecvKeys.Num()))
+			RecvKeys.Add(NAME_None);
+	}
+}
+
+void UGMPRpcProxy::RPC_Request_Implementation(UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
+{
+	CallLocalFunction(InObject, FindRecvKey(KeyId), Buffer);
+}
+
+bool UGMPRpcProxy::VerifyFunctionRequest(UObject* InObject, FName FunName, int32 NumBytes) const
+{
+	UFunction* Func = (!FunName.IsNone() && (NumBytes <= MaxByteCount) && IsValid(InObject)) ? InObject->FindFunction(FunName) : nullptr;
+	if (!(Func && Func->HasAnyFunctionFlags(FUNC_NetRequest) && NumBytes <= Func->ParmsSize))
+	{
+		GMP_WARNING(TEXT("VerifyFunctionRequest : %s in %s"), *FunName.ToString(), *GetNameSafe(InObject));
+		return false;
 	}
 	return true;
 }
 
-void UGMPRpcProxy::RPC_Notify_Implementation(UObject* Object, const FString& FuncName, const TArray<uint8>& Buffer)
+bool UGMPRpcProxy::VerifyMessageRequest(FName MessageName, int32 NumBytes) const
+{
+	return !MessageName.IsNone() && (NumBytes <= MaxByteCount && UGMPRpcValidation::Find(this, MessageName));
+}
+
+bool UGMPRpcProxy::RPC_Request_Validate(UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
+{
+	return ensure(VerifyFunctionRequest(InObject, FindRecvKey(KeyId), Buffer.Num()));
+}
+
+void UGMPRpcProxy::RPC_Notify_Implementation(UObject* Object, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
 {
-	CallLocalFunction(Object, *FuncName, Buffer);
+	CallLocalFunction(Object, FindRecvKey(KeyId), Buffer);
 }
 
 namespace
@@ -281,6 +448,8 @@ static FDelayedAutoRegisterHelper DelayInnerInitUGMPRpcProxy(EDelayedRegisterRun
 		}
 	});
 
+	FWorldDelegates::OnWorldPostActorTick.AddLambda([](UWorld* InWorld, ELevelTick, float) { UGMPRpcProxy::FlushCoalescedRPCs(InWorld); });
+
 	FWorldDelegates::OnPostWorldCleanup.AddLambda([](UWorld* InWorld, bool bSessionEnded, bool bCleanupResources) {
 		if (!GIsEditor || (InWorld && InWorld->IsGameWorld()))
 		{
@@ -317,12 +486,15 @@ bool UGMPRpcProxy::CallFunctionRemote(APlayerController* PC, UObject* InObject,
 		UGMPRpcProxy* Comp = PC ? PC->FindComponentByClass<UGMPRpcProxy>() : nullptr;
 		if (ensureWorldMsgf(InObject, Comp, TEXT("Found No Comp : %s"), *GetNameSafe(PC)))
 		{
-			if (Comp->ScopedCnt > 0)
-				Comp->PendingRPCs.Emplace(InObject, InFunctionName.ToString(), MoveTemp(Buffer), true);
+			const FGMPRpcKeyId KeyId = Comp->InternSendKey(InFunctionName);
+			if (GMP::RpcCoalesce::bEnabled)
+				Comp->QueueFrameRPC(InObject, InFunctionName, KeyId, MoveTemp(Buffer), true, true);
+			else if (Comp->ScopedCnt > 0)
+				Comp->PendingRPCs.Emplace(InObject, KeyId, MoveTemp(Buffer), true);
 			else if (bClient)
-				Comp->RPC_Request(InObject, InFunctionName.ToString(), Buffer);
+				Comp->RPC_Request(InObject, KeyId, Buffer);
 			else
-				Comp->RPC_Notify(InObject, InFunctionName.ToString(), Buffer);
+				Comp->RPC_Notify(InObject, KeyId, Buffer);
 			return true;
 		}
 	}
@@ -345,9 +517,9 @@ void UGMPRpcProxy::DispatchPendingProgress(const TArray<FGMPRpcBatchData>& Batch
 	for (auto& Data : Batcher)
 	{
 		if (Data.bFunction)
-			CallLocalFunction(Data.Obj, *Data.Key, Data.Buff);
+			CallLocalFunction(Data.Obj, FindRecvKey(Data.KeyId), Data.Buff);
 		else
-			CallLocalMessage(Data.Obj, Data.Key, Data.Buff);
+			CallLocalMessage(Data.Obj, FindRecvKey(Data.KeyId), Data.Buff);
 	}
 }
 
@@ -367,7 +539,412 @@ void UGMPRpcProxy::Batch_Notify_Implementation(const TArray<FGMPRpcBatchData>& B
 }
 
 //////////////////////////////////////////////////////////////////////////
-void UGMPRpcProxy::CallMessageRemote(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool bReliable)
+void UGMPRpcProxy::SetUnreliablePolicy(FName MessageKey, EGMPRpcUnreliablePolicy Policy)
+{
+	if (Policy == EGMPRpcUnreliablePolicy::Keep)
+		GMP::RpcCoalesce::Policies.Remove(MessageKey);
+	else
+		GMP::RpcCoalesce::Policies.Add(MessageKey, Policy);
+}
+
+void UGMPRpcProxy::QueueFrameRPC(UObject* InObject, FName Key, FGMPRpcKeyId KeyId, TArray<uint8>&& Buffer, bool bFunction, bool bReliable, TArrayView<const int32> ArgBitEnds)
+{
+	using namespace GMP;
+	++RpcCoalesce::Stats.Queued;
+	if (!bFrameQueued)
+	{
+		bFrameQueued = true;
+		RpcCoalesce::QueuedProxies.Add(this);
+	}
+
+	if (bReliable)
+	{
+		FrameRPCs.Emplace(InObject, KeyId, MoveTemp(Buffer), bFunction);
+		return;
+	}
+
+	// delta entries keep the full snapshot until flush, so superseding one loses no changes
+	const EGMPRpcUnreliablePolicy Policy = RpcCoalesce::Policies.FindRef(Key);
+	const bool bDelta = RpcCoalesce::UseDelta(Key, ArgBitEnds);
+	if (Policy == EGMPRpcUnreliablePolicy::Latest || bDelta)
+	{
+		auto Find = FrameUnreliables.FindByPredicate([&](const FGMPRpcBatchData& Data) { return Data.KeyId.Id == KeyId.Id && Data.Obj == InObject; });
+		if (Find)
+		{
+			FrameUnreliableBytes += Buffer.Num() - Find->Buff.Num();
+			Find->Buff = MoveTemp(Buffer);
+			if (bDelta)
+				Find->ArgBitEnds = TArray<int32>(ArgBitEnds.GetData(), ArgBitEnds.Num());
+			++RpcCoalesce::Stats.Superseded;
+			return;
+		}
+	}
+	else if (Policy == EGMPRpcUnreliablePolicy::Droppable && FrameUnreliableBytes + Buffer.Num() > RpcCoalesce::UnreliableFrameBytes)
+	{
+		++RpcCoalesce::Stats.Dropped;
+		return;
+	}
+
+	FrameUnreliableBytes += Buffer.Num();
+	auto& Data = FrameUnreliables.Emplace_GetRef(InObject, KeyId, MoveTemp(Buffer), bFunction);
+	if (bDelta)
+		Data.ArgBitEnds = TArray<int32>(ArgBitEnds.GetData(), ArgBitEnds.Num());
+}
+
+void UGMPRpcProxy::FlushCoalescedRPCs(UWorld* World)
+{
+	using namespace GMP;
+	for (int32 Idx = RpcCoalesce::QueuedProxies.Num() - 1; Idx >= 0; --Idx)
+	{
+		UGMPRpcProxy* Proxy = RpcCoalesce::QueuedProxies[Idx].Get();
+		if (Proxy && Proxy->GetWorld() != World)
+			continue;
+
+		RpcCoalesce::QueuedProxies.RemoveAtSwap(Idx);
+		if (Proxy)
+			Proxy->FlushFrameRPCs();
+	}
+}
+
+void UGMPRpcProxy::FlushFrameRPCs()
+{
+	using namespace GMP;
+	bFrameQueued = false;
+	FrameUnreliableBytes = 0;
+
+	for (int32 Idx = FrameUnreliables.Num() - 1; Idx >= 0; --Idx)
+	{
+		auto& Data = FrameUnreliables[Idx];
+		if (Data.ArgBitEnds.Num() > 0 && !EncodeDelta(Data.Obj, Data.KeyId, Data.Buff, Data.ArgBitEnds))
+			FrameUnreliables.RemoveAt(Idx);
+	}
+
+	// entry : function bit, delta bit, object, packed key id, packed byte count, payload
+	auto PackageMap = UGMPBPLib::GetPackageMap(CastChecked<APlayerController>(GetOwner()));
+	// entries above MaxByteCount go out on their own rpc in between two streams, so the order is kept
+	auto IsOversized = [](const FGMPRpcBatchData& Data) { return Data.Buff.Num() > MaxByteCount; };
+	auto WriteStreams = [&](TArray<FGMPRpcBatchData>& Entries, auto&& SendStream, auto&& SendSingle) {
+		int32 Index = 0;
+		while (Index < Entries.Num())
+		{
+			if (IsOversized(Entries[Index]))
+			{
+				SendSingle(Entries[Index++]);
+				continue;
+			}
+
+			FGMPNetBitWriter Writer(PackageMap, 0);
+			int32 Num = 0;
+			do
+			{
+				auto& Data = Entries[Index++];
+				Writer.WriteBit(Data.bFunction ? 1 : 0);
+				Writer.WriteBit(Data.ArgBitEnds.Num() > 0 ? 1 : 0);
+				Writer << Data.Obj;
+				Writer.SerializeIntPacked(Data.KeyId.Id);
+				uint32 NumBytes = Data.Buff.Num();
+				Writer.SerializeIntPacked(NumBytes);
+				Writer.Serialize(Data.Buff.GetData(), NumBytes);
+				++Num;
+			} while (Index < Entries.Num() && !IsOversized(Entries[Index]) && Writer.GetNumBytes() + Entries[Index].Buff.Num() + 16 <= MaxStreamByteCount);
+
+			++RpcCoalesce::Stats.Streams;
+			SendStream(Num, *Writer.GetBuffer());
+		}
+		Entries.Reset();
+	};
+
+	const bool bClient = (GetNetMode() != NM_DedicatedServer);
+	WriteStreams(
+		FrameRPCs,
+		[&](int32 Num, const TArray<uint8>& Stream) {
+			if (bClient)
+				Stream_Request(Num, Stream);
+			else
+				Stream_Notify(Num, Stream);
+		},
+		[&](const FGMPRpcBatchData& Data) {
+			if (Data.bFunction)
+			{
+				if (bClient)
+					RPC_Request(Data.Obj, Data.KeyId, Data.Buff);
+				else
+					RPC_Notify(Data.Obj, Data.KeyId, Data.Buff);
+			}
+			else if (bClient)
+			{
+				Message_Request(Data.Obj, Data.KeyId, Data.Buff);
+			}
+			else
+			{
+				Message_Notify(Data.Obj, Data.KeyId, Data.Buff);
+			}
+		});
+	WriteStreams(
+		FrameUnreliables,
+		[&](int32 Num, const TArray<uint8>& Stream) { Unreliable_Stream_Notify(Num, Stream); },
+		[&](const FGMPRpcBatchData& Data) {
+			// delta entries were encoded above
+			if (Data.ArgBitEnds.Num() > 0)
+				Unreliable_Delta_Notify(Data.Obj, Data.KeyId, Data.Buff);
+			else
+				Unreliable_Notify(Data.Obj, Data.KeyId, Data.Buff);
+		});
+}
+
+bool UGMPRpcProxy::ReadStream(int32 Num, const TArray<uint8>& Stream, FStreamEntryFunc Func)
+{
+	auto PackageMap = UGMPBPLib::GetPackageMap(CastChecked<APlayerController>(GetOwner()));
+	FGMPNetBitReader Reader{PackageMap, const_cast<uint8*>(Stream.GetData()), Stream.Num() * 8};
+	TArray<uint8> Buffer;
+	for (int32 Idx = 0; Idx < Num; ++Idx)
+	{
+		const bool bFunction = !!Reader.ReadBit();
+		const bool bDelta = !!Reader.ReadBit();
+		UObject* Obj = nullptr;
+		Reader << Obj;
+		FGMPRpcKeyId KeyId;
+		Reader.SerializeIntPacked(KeyId.Id);
+		uint32 NumBytes = 0;
+		Reader.SerializeIntPacked(NumBytes);
+		// the byte limit of client requests is checked by Stream_Request_Validate, notifies are as large as the server sends them
+		if (Reader.IsError() || Reader.GetBitsLeft() < int64(NumBytes) * 8)
+		{
+			GMP_WARNING(TEXT("ReadStream : broken stream at %d of %d"), Idx, Num);
+			return false;
+		}
+		Buffer.Reset(NumBytes);
+		Buffer.AddUninitialized(NumBytes);
+		Reader.Serialize(Buffer.GetData(), NumBytes);
+
+		// unknown ids are passed as NAME_None, Func decides whether they reject the stream
+		if (!Func(bFunction, bDelta, Obj, FindRecvKey(KeyId), KeyId, Buffer))
+			return false;
+	}
+	return true;
+}
+
+void UGMPRpcProxy::DispatchStream(int32 Num, const TArray<uint8>& Stream)
+{
+	ReadStream(Num, Stream, [this](bool bFunction, bool bDelta, UObject* Obj, FName Key, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer) {
+		// unknown ids come from unreliable streams that overtook their key definition
+		if (Key.IsNone())
+			return true;
+		if (bFunction)
+			CallLocalFunction(Obj, Key, Buffer);
+		else if (bDelta)
+			ReceiveDelta(Obj, Key, KeyId, Buffer);
+		else
+			CallLocalMessage(Obj, Key, Buffer);
+		return true;
+	});
+}
+
+bool UGMPRpcProxy::Stream_Request_Validate(int32 Num, const TArray<uint8>& Stream)
+{
+	// every entry takes more than one byte
+	if (!ensureAlwaysMsgf(Num >= 0 && Num <= Stream.Num() && Stream.Num() <= MaxStreamByteCount, TEXT("Stream_Request_Validate : %d entries in %d bytes"), Num, Stream.Num()))
+		return false;
+
+	// one bad entry rejects the whole stream and drops the connection, same as RPC_Request_Validate
+	return ensureAlwaysMsgf(ReadStream(Num,
+									   Stream,
+									   [this](bool bFunction, bool bDelta, UObject* Obj, FName Key, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer) {
+										   // clients never send delta entries, an unknown key id is rejected by both verifies
+										   return bFunction ? VerifyFunctionRequest(Obj, Key, Buffer.Num()) : (!bDelta && VerifyMessageRequest(Key, Buffer.Num()));
+									   }),
+							TEXT("Stream_Request_Validate : rejected stream of %d entries"),
+							Num);
+}
+
+void UGMPRpcProxy::Stream_Request_Implementation(int32 Num, const TArray<uint8>& Stream)
+{
+	DispatchStream(Num, Stream);
+}
+
+void UGMPRpcProxy::Stream_Notify_Implementation(int32 Num, const TArray<uint8>& Stream)
+{
+	DispatchStream(Num, Stream);
+}
+
+void UGMPRpcProxy::Unreliable_Stream_Notify_Implementation(int32 Num, const TArray<uint8>& Stream)
+{
+	DispatchStream(Num, Stream);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// payload : packed seq, packed base seq (0 for a full snapshot), packed arg count, packed changed mask, then bit count and bits of each changed arg
+bool UGMPRpcProxy::EncodeDelta(const UObject* Sender, FGMPRpcKeyId KeyId, TArray<uint8>& Buffer, TArrayView<const int32> ArgBitEnds)
+{
+	using namespace GMP;
+	const FDeltaStateKey StateKey(KeyId.Id, FObjectKey(Sender));
+	const int32 NumBefore = SendDeltas.Num();
+	auto* StatePtr = &SendDeltas.FindOrAdd(StateKey);
+	if (SendDeltas.Num() > NumBefore && (SendDeltas.Num() % 1024) == 0)
+	{
+		RpcCoalesce::PruneDeltaStates(SendDeltas);
+		StatePtr = &SendDeltas.FindOrAdd(StateKey);
+	}
+	auto& State = *StatePtr;
+
+	const int32 NumArgs = ArgBitEnds.Num();
+	const double Now = FPlatformTime::Seconds();
+	const bool bFull = State.bForceFull || State.Args.Num() != NumArgs || (Now - State.LastFullTime) >= RpcCoalesce::DeltaFullInterval;
+	State.Args.SetNum(NumArgs);
+	State.ArgBits.SetNum(NumArgs);
+
+	uint32 Mask = 0;
+	FBitReader Reader(Buffer.GetData(), ArgBitEnds.Last());
+	TArray<uint8> Arg;
+	for (int32 Idx = 0; Idx < NumArgs; ++Idx)
+	{
+		const int32 NumBits = ArgBitEnds[Idx] - (Idx > 0 ? ArgBitEnds[Idx - 1] : 0);
+		Arg.Reset();
+		Arg.AddZeroed((NumBits + 7) >> 3);
+		Reader.SerializeBits(Arg.GetData(), NumBits);
+		if (bFull || State.ArgBits[Idx] != NumBits || State.Args[Idx] != Arg)
+		{
+			Mask |= 1u << Idx;
+			State.ArgBits[Idx] = NumBits;
+			Swap(State.Args[Idx], Arg);
+		}
+	}
+
+	if (!Mask)
+	{
+		++RpcCoalesce::Stats.DeltaUnchanged;
+		return false;
+	}
+
+	uint32 BaseSeq = bFull ? 0 : State.Seq;
+	if (++State.Seq == 0)
+		State.Seq = 1;
+	if (bFull)
+	{
+		State.bForceFull = false;
+		State.LastFullTime = Now;
+		++RpcCoalesce::Stats.DeltaFull;
+	}
+	else
+	{
+		++RpcCoalesce::Stats.DeltaPartial;
+	}
+
+	FBitWriter Writer(0, true);
+	uint32 Seq = State.Seq;
+	uint32 Num = NumArgs;
+	Writer.SerializeIntPacked(Seq);
+	Writer.SerializeIntPacked(BaseSeq);
+	Writer.SerializeIntPacked(Num);
+	Writer.SerializeIntPacked(Mask);
+	for (int32 Idx = 0; Idx < NumArgs; ++Idx)
+	{
+		if (!(Mask & (1u << Idx)))
+			continue;
+		uint32 NumBits = State.ArgBits[Idx];
+		Writer.SerializeIntPacked(NumBits);
+		Writer.SerializeBits(State.Args[Idx].GetData(), NumBits);
+	}
+	Buffer = *Writer.GetBuffer();
+	return true;
+}
+
+void UGMPRpcProxy::ReceiveDelta(const UObject* InObject, FName MessageName, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
+{
+	using namespace GMP;
+	FBitReader Reader(const_cast<uint8*>(Buffer.GetData()), Buffer.Num() * 8);
+	uint32 Seq = 0;
+	uint32 BaseSeq = 0;
+	uint32 NumArgs = 0;
+	uint32 Mask = 0;
+	Reader.SerializeIntPacked(Seq);
+	Reader.SerializeIntPacked(BaseSeq);
+	Reader.SerializeIntPacked(NumArgs);
+	Reader.SerializeIntPacked(Mask);
+	if (Reader.IsError() || NumArgs == 0 || NumArgs > 32)
+		return;
+
+	const FDeltaStateKey StateKey(KeyId.Id, FObjectKey(InObject));
+	const int32 NumBefore = RecvDeltas.Num();
+	auto* StatePtr = &RecvDeltas.FindOrAdd(StateKey);
+	if (RecvDeltas.Num() > NumBefore && (RecvDeltas.Num() % 1024) == 0)
+	{
+		RpcCoalesce::PruneDeltaStates(RecvDeltas);
+		StatePtr = &RecvDeltas.FindOrAdd(StateKey);
+	}
+	auto& State = *StatePtr;
+
+	// unreliable packets may arrive late, never go back to an older snapshot
+	const bool bFull = (BaseSeq == 0);
+	if (State.Seq != 0 && int32(Seq - State.Seq) <= 0)
+		return;
+
+	const uint32 AllMask = (NumArgs == 32) ? ~0u : ((1u << NumArgs) - 1);
+	if (bFull ? (Mask != AllMask) : (BaseSeq != State.Seq || State.Args.Num() != int32(NumArgs)))
+	{
+		// a delta was lost, wait for the next full snapshot
+		if (!State.bResyncPending)
+		{
+			State.bResyncPending = true;
+			++RpcCoalesce::Stats.DeltaResync;
+			Delta_Resync(InObject, KeyId);
+		}
+		return;
+	}
+
+	TArray<TArray<uint8>> Args = State.Args;
+	TArray<int32> ArgBits = State.ArgBits;
+	Args.SetNum(int32(NumArgs));
+	ArgBits.SetNum(int32(NumArgs));
+	for (uint32 Idx = 0; Idx < NumArgs; ++Idx)
+	{
+		if (!(Mask & (1u << Idx)))
+			continue;
+		uint32 NumBits = 0;
+		Reader.SerializeIntPacked(NumBits);
+		if (Reader.IsError() || NumBits > uint32(MaxByteCount * 8) || Reader.GetBitsLeft() < int64(NumBits))
+		{
+			GMP_WARNING(TEXT("ReceiveDelta : broken payload for %s"), *MessageName.ToString());
+			return;
+		}
+		Args[Idx].Reset();
+		Args[Idx].AddZeroed((NumBits + 7) >> 3);
+		Reader.SerializeBits(Args[Idx].GetData(), NumBits);
+		ArgBits[Idx] = NumBits;
+	}
+
+	State.Args = MoveTemp(Args);
+	State.ArgBits = MoveTemp(ArgBits);
+	State.Seq = Seq;
+	if (bFull)
+		State.bResyncPending = false;
+
+	FBitWriter Writer(0, true);
+	for (uint32 Idx = 0; Idx < NumArgs; ++Idx)
+		Writer.SerializeBits(State.Args[Idx].GetData(), State.ArgBits[Idx]);
+	CallLocalMessage(InObject, MessageName, *Writer.GetBuffer());
+}
+
+void UGMPRpcProxy::Unreliable_Delta_Notify_Implementation(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
+{
+	FName MessageName = FindRecvKey(KeyId);
+	if (!MessageName.IsNone())
+		ReceiveDelta(InObject, MessageName, KeyId, Buffer);
+}
+
+bool UGMPRpcProxy::Delta_Resync_Validate(const UObject* InObject, FGMPRpcKeyId KeyId)
+{
+	return KeyId.Id < uint32(SendKeyIds.Num());
+}
+
+void UGMPRpcProxy::Delta_Resync_Implementation(const UObject* InObject, FGMPRpcKeyId KeyId)
+{
+	if (auto State = SendDeltas.Find(FDeltaStateKey(KeyId.Id, FObjectKey(InObject))))
+		State->bForceFull = true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void UGMPRpcProxy::CallMessageRemote(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool bReliable, TArrayView<const int32> ArgBitEnds)
 {
 	if (auto World = GEngine->GetWorldFromContextObject(Sender, EGetWorldErrorMode::LogAndReturnNull))
 	{
@@ -378,140 +955,101 @@ void UGMPRpcProxy::CallMessageRemote(APlayerController* PC, const UObject* Sende
 		UGMPRpcProxy* Comp = PC ? PC->FindComponentByClass<UGMPRpcProxy>() : nullptr;
 		if (ensureWorldMsgf(Sender, Comp, TEXT("Found No Comp:%s"), *GetNameSafe(PC)))
 		{
-			if (Comp->ScopedCnt > 0)
-				Comp->PendingRPCs.Emplace(const_cast<UObject*>(Sender), FString(MessageStr), MoveTemp(Buffer), false);
+			const FName MessageName(*MessageStr);
+			const FGMPRpcKeyId KeyId = Comp->InternSendKey(MessageName);
+			if (GMP::RpcCoalesce::bEnabled)
+				Comp->QueueFrameRPC(const_cast<UObject*>(Sender), MessageName, KeyId, MoveTemp(Buffer), false, bReliable || bClient, ArgBitEnds);
+			else if (Comp->ScopedCnt > 0)
+				Comp->PendingRPCs.Emplace(const_cast<UObject*>(Sender), KeyId, MoveTemp(Buffer), false);
 			else if (bClient)
-				Comp->Message_Request(Sender, MessageStr, Buffer);
+				Comp->Message_Request(Sender, KeyId, Buffer);
 			else if (bReliable)
-				Comp->Message_Notify(Sender, MessageStr, Buffer);
-			else
-				Comp->Unreliable_Notify(Sender, MessageStr, Buffer);
+				Comp->Message_Notify(Sender, KeyId, Buffer);
+			else if (!GMP::RpcCoalesce::UseDelta(MessageName, ArgBitEnds))
+				Comp->Unreliable_Notify(Sender, KeyId, Buffer);
+			else if (Comp->EncodeDelta(Sender, KeyId, Buffer, ArgBitEnds))
+				Comp->Unreliable_Delta_Notify(Sender, KeyId, Buffer);
 		}
 	}
 }
 
-void UGMPRpcProxy::Message_Request_Implementation(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer)
+void UGMPRpcProxy::Message_Request_Implementation(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
 {
-	CallLocalMessage(InObject, MessageStr, Buffer);
+	CallLocalMessage(InObject, FindRecvKey(KeyId), Buffer);
 }
 
-bool UGMPRpcProxy::Message_Request_Validate(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer)
+bool UGMPRpcProxy::Message_Request_Validate(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
 {
-	FName MessageName(*MessageStr, FNAME_Find);
-	bool bValidate = MessageName.IsValid() && (Buffer.Num() <= MaxByteCount && UGMPRpcValidation::Find(this, MessageName));
-	return ensureAlwaysMsgf(bValidate, TEXT("Message_Request_Validate : %s with %s"), *MessageStr, *GetNameSafe(InObject));
+	FName MessageName = FindRecvKey(KeyId);
+	return ensureAlwaysMsgf(VerifyMessageRequest(MessageName, Buffer.Num()), TEXT("Message_Request_Validate : %s with %s"), *MessageName.ToString(), *GetNameSafe(InObject));
 }
 
-void UGMPRpcProxy::Message_Notify_Implementation(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer)
+void UGMPRpcProxy::Message_Notify_Implementation(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
 {
-	CallLocalMessage(InObject, MessageStr, Buffer);
+	CallLocalMessage(InObject, FindRecvKey(KeyId), Buffer);
 }
-void UGMPRpcProxy::Unreliable_Notify_Implementation(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer)
+void UGMPRpcProxy::Unreliable_Notify_Implementation(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)
 {
-	CallLocalMessage(InObject, MessageStr, Buffer);
+	// may overtake the reliable definition of its key, drop it then
+	FName MessageName = FindRecvKey(KeyId);
+	if (!MessageName.IsNone())
+		CallLocalMessage(InObject, MessageName, Buffer);
 }
 
-bool UGMPRpcProxy::CallLocalMessage(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer)
+bool UGMPRpcProxy::CallLocalMessage(const UObject* InObject, FName MessageName, const TArray<uint8>& Buffer)
 {
 	using namespace GMP;
-	FName MessageName(*MessageStr, FNAME_Find);
-	const TArray<FProperty*>* Find = MessageName.IsValid() ? UGMPRpcValidation::Find(this, MessageName) : nullptr;
+	const TArray<FProperty*>* Find = !MessageName.IsNone() ? UGMPRpcValidation::Find(this, MessageName) : nullptr;
 	if (!ensureWorldMsgf(InObject, Find, TEXT("rpc not registered for %s"), *MessageName.ToString()))
 		return false;
 
-	if (!ensureWorldMsgf(InObject, FMessageUtils::GetMessageHub()->IsAlive(MessageName), TEXT("no listener for %s"), *MessageStr))
+	if (!ensureWorldMsgf(InObject, FMessageUtils::GetMessageHub()->IsAlive(MessageName), TEXT("no listener for %s"), *MessageName.ToString()))
 		return false;
 
-	return LocalBroadcastMessage(MessageStr, *Find, InObject, Buffer);
+	return LocalBroadcastMessage(MessageName, *Find, InObject, Buffer);
 }
 
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4750)  // warning C4750: function with _alloca() inlined into a loop
 #endif
-bool UGMPRpcProxy::LocalBroadcastMessage(const FString& MessageStr, const TArray<FProperty*>& Props, const UObject* Sender, const TArray<uint8>& Buffer)
+bool UGMPRpcProxy::LocalBroadcastMessage(FName MessageName, const TArray<FProperty*>& Props, const UObject* Sender, const TArray<uint8>& Buffer)
 {
 	using namespace GMP;
-	bool bSucc = true;
-	GMP::FTypedAddresses Params;
-	Params.Empty(Props.Num());
+	const FGMPRpcRecvPlan& Plan = UGMPRpcValidation::FindRecvPlan(this, MessageName, Props);
 	auto PackageMap = UGMPBPLib::GetPackageMap(CastChecked<APlayerController>(GetOwner()));
-	struct FFrameOnScope
-	{
-		FFrameOnScope(const TArray<FProperty*>& Props)
-		{
-			for (auto Prop : Props)
-			{
-				LocalTotalSize += GMP::GetElementSize(Prop);
-			}
-			Locals = (uint8*)FMemory_Alloca(LocalTotalSize);
-		}
-
-		uint8* Alloca(FProperty* InProp)
-		{
-			auto Ret = Locals;
-			Locals += GMP::GetElementSize(InProp);
-			return Ret;
-		}
-
-		int32 LocalTotalSize = 0;
-		uint8* Locals = nullptr;
-	};
+	uint8* Frame = (uint8*)FMemory_Alloca_Aligned(FMath::Max(Plan.FrameSize, 1), Plan.FrameAlign);
 
-#if defined(GMP_USING_SINGLE_ELEMENT_ALLOCATION)
-#define AllocaByProp(Prop, Scope) (uint8*)FMemory_Alloca_Aligned(GMP::GetElementSize(Prop), Prop->GetMinAlignment())
-#else
-#define AllocaByProp(Prop, Scope) Scope.Alloca(Prop)
-#endif
+	GMP::FTypedAddresses Params;
+	Params.Empty(Props.Num());
+	for (int32 Idx = 0; Idx < Props.Num(); ++Idx)
+		Add_GetRef(Params).SetAddr(Frame + Plan.Offsets[Idx], Props[Idx]);
+	for (int32 Idx : Plan.InitIndices)
+		Props[Idx]->InitializeValue_InContainer(Frame + Plan.Offsets[Idx]);
 
-	FFrameOnScope Scope(Props);
-#if 1
+	bool bSucc = true;
 	FGMPNetBitReader Reader{PackageMap, const_cast<uint8*>(Buffer.GetData()), Buffer.Num() * 8};
-	int Index = 0;
-	for (; Index < Props.Num();)
+	for (auto& Step : Plan.Steps)
 	{
-		auto* Prop = Props[Index++];
-		uint8* Locals = AllocaByProp(Prop, Scope);
-		Prop->InitializeValue_InContainer(Locals);
-		Add_GetRef(Params).SetAddr(Locals, Prop);
-
-		if (!UGMPBPLib::NetSerializeProperty(Reader, Prop, Locals, PackageMap))
+		if (Step.NumBytes > 0)
+		{
+			Reader.SerializeBits(Frame + Step.Offset, Step.NumBytes * 8);
+		}
+		else if (!UGMPBPLib::NetSerializeProperty(Reader, Props[Step.PropIndex], Frame + Step.Offset, PackageMap))
 		{
 			bSucc = false;
 			break;
 		}
 	}
 
+	bSucc = bSucc && ensureWorld(this, !Reader.IsError());
 	if (bSucc)
 	{
-		FMessageUtils::GetMessageHub()->ScriptNotifyMessage(MessageStr, Params, Sender ? Sender : GetWorld());
-	}
-
-	for (--Index; Index >= 0; --Index)
-	{
-		Props[Index]->DestroyValue_InContainer(Params[Index].ToAddr());
+		FMessageUtils::GetMessageHub()->ScriptNotifyMessage(MessageName, Params, Sender ? Sender : GetWorld());
 	}
 
-#else
-
-	for (auto Prop : Props)
-	{
-		uint8* Locals = AllocaByProp(Prop, Scope);
-		Prop->InitializeValue_InContainer(Locals);
-		Add_GetRef(Params).SetAddr(Locals, Prop);
-		Locals = Locals + GMP::GetElementSize(Prop);
-	}
-
-	if (!UGMPBPLib::ArchiveToMessage(Buffer, Params, Props, PackageMap))
-		return false;
-
-	FMessageUtils::GetMessageHub()->ScriptNotifyMessage(MessageStr, Params, Sender ? Sender : GetWorld());
-	for (auto i = 0; i < Props.Num(); ++i)
-	{
-		Props[i]->DestroyValue_InContainer(Params[i].ToAddr());
-	}
-
-#endif
+	for (int32 Idx : Plan.DestroyIndices)
+		Props[Idx]->DestroyValue_InContainer(Frame + Plan.Offsets[Idx]);
 	return bSucc;
 }
 #ifdef _MSC_VER
@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 
 #include "Components/ActorComponent.h"
+#include "GMPRpcUtils.h"
 #include "GMPTypeTraits.h"
 #include "Templates/SubclassOf.h"
 #include "UObject/CoreNet.h"
+#include "UObject/ObjectKey.h"
 #include "UObject/WeakObjectPtr.h"
 #include "UObject/WeakObjectPtrTemplates.h"
 
@@ -15,15 +17,46 @@
 
 class APlayerController;
 
+// index of a message or function name in the key dictionary of one connection
+USTRUCT()
+struct GMP_API FGMPRpcKeyId
+{
+	GENERATED_BODY()
+public:
+	FGMPRpcKeyId() = default;
+	explicit FGMPRpcKeyId(uint32 InId)
+		: Id(InId)
+	{
+	}
+
+	UPROPERTY()
+	uint32 Id = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		Ar.SerializeIntPacked(Id);
+		bOutSuccess = !Ar.IsError();
+		return true;
+	}
+};
+template<>
+struct TStructOpsTypeTraits<FGMPRpcKeyId> : public TStructOpsTypeTraitsBase2<FGMPRpcKeyId>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
 USTRUCT()
 struct GMP_API FGMPRpcBatchData
 {
 	GENERATED_BODY()
 public:
 	FGMPRpcBatchData() = default;
-	FGMPRpcBatchData(UObject* InObj, FString InKey, TArray<uint8>&& InBuff, bool bFunc)
+	FGMPRpcBatchData(UObject* InObj, FGMPRpcKeyId InKeyId, TArray<uint8>&& InBuff, bool bFunc)
 		: Obj(InObj)
-		, Key(MoveTemp(InKey))
+		, KeyId(InKeyId)
 		, Buff(MoveTemp(InBuff))
 		, bFunction(bFunc)
 	{
@@ -33,13 +66,27 @@ public:
 	UObject* Obj = nullptr;
 
 	UPROPERTY()
-	FString Key;
+	FGMPRpcKeyId KeyId;
 
 	UPROPERTY()
 	TArray<uint8> Buff;
 
 	UPROPERTY()
 	bool bFunction = false;
+
+	// sender only, where each argument ends in Buff when it is delta encoded
+	TArray<int32> ArgBitEnds;
+};
+
+// last snapshot of one message key and sender, arguments are kept as separate bit chunks
+struct FGMPRpcDeltaState
+{
+	TArray<TArray<uint8>> Args;
+	TArray<int32> ArgBits;
+	uint32 Seq = 0;
+	double LastFullTime = 0.0;
+	bool bForceFull = true;
+	bool bResyncPending = false;
 };
 
 UCLASS(Transient)
@@ -65,6 +112,25 @@ protected:
 	TMap<FName, TObjectPtr<UScriptStruct>> ScriptStructs;
 };
 
+// how a received message is read into a stack frame, built once per message key
+struct FGMPRpcRecvPlan
+{
+	struct FStep
+	{
+		int32 PropIndex = 0;
+		int32 Offset = 0;
+		int32 NumBytes = 0;  // a run of numeric args read with one bit copy, 0 for a single property read
+	};
+	TArray<FStep> Steps;
+	TArray<int32> Offsets;
+	TArray<int32> InitIndices;     // args needing construction, numeric runs are overwritten whole
+	TArray<int32> DestroyIndices;  // args with a destructor
+	int32 FrameSize = 0;
+	int32 FrameAlign = 1;
+
+	static FGMPRpcRecvPlan Build(const TArray<FProperty*>& Props);
+};
+
 UCLASS(Transient)
 class UGMPRpcValidation final : public UObject
 {
@@ -75,6 +141,9 @@ public:
 
 	TMap<FName, TArray<FProperty*>> RPCProcessors;
 
+	static const FGMPRpcRecvPlan& FindRecvPlan(const UObject* Obj, const FName& MessageKey, const TArray<FProperty*>& Props);
+	TMap<FName, TUniquePtr<FGMPRpcRecvPlan>> RecvPlans;
+
 	static int32 GetNextPlayerSequence(const APlayerController& PC);
 	int32 PlayerSequenceID = 0;
 };
@@ -98,24 +167,40 @@ protected:
 	virtual void InitializeComponent() override;
 
 	//////////////////////////////////////////////////////////////////////////
+	// message and function names are sent once per connection over a reliable rpc, then referred to by id
 protected:
-	bool CallLocalMessage(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer);
-	bool LocalBroadcastMessage(const FString& MessageStr, const TArray<FProperty*>& Props, const UObject* InObject, const TArray<uint8>& Buffer);
+	static const int32 MaxKeyCount;
+	FGMPRpcKeyId InternSendKey(FName Key);
+	FName FindRecvKey(FGMPRpcKeyId KeyId) const { return RecvKeys.IsValidIndex(KeyId.Id) ? RecvKeys[KeyId.Id] : NAME_None; }
+	bool DefineRecvKey(FGMPRpcKeyId KeyId, const FString& Key);
 
 	UFUNCTION(Server, Reliable, WithValidation)
-	void Message_Request(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer);
+	void Key_Define_Request(FGMPRpcKeyId KeyId, const FString& Key);
 	UFUNCTION(Client, Reliable)
-	void Message_Notify(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer);
+	void Key_Define_Notify(FGMPRpcKeyId KeyId, const FString& Key);
+
+	TMap<FName, uint32> SendKeyIds;
+	TArray<FName> RecvKeys;
+
+	//////////////////////////////////////////////////////////////////////////
+protected:
+	bool CallLocalMessage(const UObject* InObject, FName MessageName, const TArray<uint8>& Buffer);
+	bool LocalBroadcastMessage(FName MessageName, const TArray<FProperty*>& Props, const UObject* InObject, const TArray<uint8>& Buffer);
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Message_Request(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer);
+	UFUNCTION(Client, Reliable)
+	void Message_Notify(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer);
 	UFUNCTION(Client, unreliable)
-	void Unreliable_Notify(const UObject* InObject, const FString& MessageStr, const TArray<uint8>& Buffer);
+	void Unreliable_Notify(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer);
 
 	//////////////////////////////////////////////////////////////////////////
 protected:
 	void CallLocalFunction(UObject* InUserObject, FName InFunctionName, const TArray<uint8>& Buffer);
 	UFUNCTION(Server, Reliable, WithValidation)
-	void RPC_Request(UObject* Object, const FString& FuncName, const TArray<uint8>& Buffer);
+	void RPC_Request(UObject* Object, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer);
 	UFUNCTION(Client, Reliable)
-	void RPC_Notify(UObject* Object, const FString& FuncName, const TArray<uint8>& Buffer);
+	void RPC_Notify(UObject* Object, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer);
 
 protected:
 	void DispatchPendingProgress(const TArray<FGMPRpcBatchData>& Batcher);
@@ -137,8 +222,54 @@ protected:
 	}
 	friend struct FGMPRpcBatchScope;
 
+	//////////////////////////////////////////////////////////////////////////
+	// unreliable notifies of EGMPRpcUnreliablePolicy::Delta keys only carry the arguments that changed
+protected:
+	using FDeltaStateKey = TTuple<uint32, FObjectKey>;
+	bool EncodeDelta(const UObject* Sender, FGMPRpcKeyId KeyId, TArray<uint8>& Buffer, TArrayView<const int32> ArgBitEnds);
+	void ReceiveDelta(const UObject* InObject, FName MessageName, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer);
+
+	UFUNCTION(Client, unreliable)
+	void Unreliable_Delta_Notify(const UObject* InObject, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer);
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Delta_Resync(const UObject* InObject, FGMPRpcKeyId KeyId);
+
+	TMap<FDeltaStateKey, FGMPRpcDeltaState> SendDeltas;
+	TMap<FDeltaStateKey, FGMPRpcDeltaState> RecvDeltas;
+
+	//////////////////////////////////////////////////////////////////////////
+	// with gmp.rpc.coalesce on, the rpcs of one frame are written into one stream and flushed after actor tick
+protected:
+	static const int32 MaxStreamByteCount;
+	void QueueFrameRPC(UObject* InObject, FName Key, FGMPRpcKeyId KeyId, TArray<uint8>&& Buffer, bool bFunction, bool bReliable, TArrayView<const int32> ArgBitEnds = {});
+	void FlushFrameRPCs();
+	// calls Func for every entry, Key is NAME_None for an unknown key id, false if the stream is broken or Func rejects an entry
+	using FStreamEntryFunc = TFunctionRef<bool(bool bFunction, bool bDelta, UObject* Obj, FName Key, FGMPRpcKeyId KeyId, const TArray<uint8>& Buffer)>;
+	bool ReadStream(int32 Num, const TArray<uint8>& Stream, FStreamEntryFunc Func);
+	void DispatchStream(int32 Num, const TArray<uint8>& Stream);
+	bool VerifyMessageRequest(FName MessageName, int32 NumBytes) const;
+	bool VerifyFunctionRequest(UObject* InObject, FName FuncName, int32 NumBytes) const;
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Stream_Request(int32 Num, const TArray<uint8>& Stream);
+	UFUNCTION(Client, Reliable)
+	void Stream_Notify(int32 Num, const TArray<uint8>& Stream);
+	UFUNCTION(Client, unreliable)
+	void Unreliable_Stream_Notify(int32 Num, const TArray<uint8>& Stream);
+
+	UPROPERTY(Transient)
+	TArray<FGMPRpcBatchData> FrameRPCs;
+	UPROPERTY(Transient)
+	TArray<FGMPRpcBatchData> FrameUnreliables;
+	int32 FrameUnreliableBytes = 0;
+	bool bFrameQueued = false;
+
+public:
+	static void FlushCoalescedRPCs(UWorld* World);
+	static void SetUnreliablePolicy(FName MessageKey, EGMPRpcUnreliablePolicy Policy);
+
 public:
-	static void CallMessageRemote(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool bReliable = true);
+	static void CallMessageRemote(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool bReliable = true, TArrayView<const int32> ArgBitEnds = {});
 	static bool CallFunctionRemote(APlayerController* PC, UObject* InUserObject, FName InFunctionName, TArray<uint8>& Buffer);
 };
 
@@ -24,9 +24,14 @@ const int32 FRpcMessageUtils::GetMaxBytes()
 	return UGMPRpcProxy::MaxByteCount;
 }
 
-void FRpcMessageUtils::PostRPCMsg(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool bReliable)
+void FRpcMessageUtils::PostRPCMsg(APlayerController* PC, const UObject* Sender, const FString& MessageStr, TArray<uint8>& Buffer, bool bReliable, TArrayView<const int32> ArgBitEnds)
 {
-	UGMPRpcProxy::CallMessageRemote(PC, Sender, MessageStr, Buffer, bReliable);
+	UGMPRpcProxy::CallMessageRemote(PC, Sender, MessageStr, Buffer, bReliable, ArgBitEnds);
+}
+
+void FRpcMessageUtils::SetUnreliablePolicy(const FMSGKEY& MessageKey, EGMPRpcUnreliablePolicy Policy)
+{
+	UGMPRpcProxy::SetUnreliablePolicy(MessageKey, Policy);
 }
 
 APlayerController* FRpcMessageUtils::GetLocalPC(const UObject* Obj)
@@ -6,11 +6,16 @@
 #include "Engine/GameInstance.h"
 #include "Engine/GameViewportClient.h"
 #include "Engine/World.h"
+#include "GMPPropHolder.h"
+#include "GMPStruct.h"
 #include "Misc/DelayedAutoRegister.h"
+#include "Misc/ScopeRWLock.h"
 #include "XConsoleManager.h"
 
 #include <algorithm>
+#include <atomic>
 #include <set>
+#include <thread>
 
 namespace GMP
 {
@@ -32,6 +37,56 @@ static const int32 MinListenOrder = -MaxListenOrder - 1;
 FGMPListenOrder FGMPListenOrder::MaxOrder{MaxListenOrder};
 FGMPListenOrder FGMPListenOrder::MinOrder{MinListenOrder};
 FGMPListenOptions FGMPListenOptions::Default(-1, 0);
+
+#ifndef GMP_KEY_BLOCK_SIZE
+#define GMP_KEY_BLOCK_SIZE 64
+#endif
+static_assert(GMP_KEY_BLOCK_SIZE > 0 && (GMP_KEY_BLOCK_SIZE & (GMP_KEY_BLOCK_SIZE - 1)) == 0, "GMP_KEY_BLOCK_SIZE must be a power of two");
+
+namespace Internal
+{
+	// ids below the order bits, blocks never straddle a wrap since the range is a multiple of the block size
+#if GMP_KEY_ORDER_BITS > 0
+	static const int64 GMPKeyIdMask = int64((1ull << (64 - GMP_KEY_ORDER_BITS)) - 1);
+#else
+	static const int64 GMPKeyIdMask = MAX_int64;
+#endif
+
+	// each thread reserves GMP_KEY_BLOCK_SIZE ids with one atomic op and hands them out locally
+	struct FIdBlock
+	{
+		int64 Next = 0;
+		int64 End = 0;
+	};
+	static int64 AllocBlockedId(std::atomic<int64>& Counter, FIdBlock& Block, int64 Mask)
+	{
+		int64 Id;
+		do
+		{
+			if (Block.Next == Block.End)
+			{
+				Block.Next = Counter.fetch_add(GMP_KEY_BLOCK_SIZE, std::memory_order_relaxed);
+				Block.End = Block.Next + GMP_KEY_BLOCK_SIZE;
+			}
+			Id = Block.Next++ & Mask;
+		} while (!Id);
+		return Id;
+	}
+
+	static std::atomic<int64> GMPKeyCounter(0);
+	static thread_local FIdBlock GMPKeyBlock;
+	static int64 NextGMPKeyId()
+	{
+		return AllocBlockedId(GMPKeyCounter, GMPKeyBlock, GMPKeyIdMask);
+	}
+
+	static std::atomic<int64> SequenceCounter(0);
+	static thread_local FIdBlock SequenceBlock;
+	int64 NextSequenceId()
+	{
+		return AllocBlockedId(SequenceCounter, SequenceBlock, MAX_int64);
+	}
+}  // namespace Internal
 }  // namespace GMP
 
 #if !UE_BUILD_SHIPPING
@@ -58,11 +113,7 @@ static void GMPDebug(FName MessageKey, GMP::FSigElm* Elm, const TCHAR* Desc)
 
 FGMPKey FGMPKey::NextGMPKey(GMP::FGMPListenOptions Options)
 {
-	static std::atomic<int64> GNextID(1);
-	int64 GMPKey = ++GNextID;
-	// static_assert((-1ll << (64 - GMP_KEY_ORDER_BITS)) == -(1ll << (64 - GMP_KEY_ORDER_BITS)), "err");
-	if (GMPKey == (GMP_WITH_SIGNAL_ORDER ? ((1ull << GMP_KEY_ORDER_BITS)) : 0))
-		GMPKey = GNextID = 1;
+	int64 GMPKey = GMP::Internal::NextGMPKeyId();
 
 #if (GMP_KEY_ORDER_BITS > 0)
 	int32 Order = FMath::Clamp(Options.Order, GMP::MinListenOrder, GMP::MaxListenOrder);
@@ -77,6 +128,47 @@ FGMPKey FGMPKey::NextGMPKey()
 	return NextGMPKey(GMP::FGMPListenOptions::Default);
 }
 
+#if !UE_BUILD_SHIPPING
+// gmp.bench.keys [count per thread] : blocked key allocation against a single shared counter at 1, 8 and 32 threads
+FXConsoleCommandLambdaFull XVar_GMPKeyBench(TEXT("gmp.bench.keys"), TEXT("gmp.bench.keys"), [](int32 Count, UWorld* InWorld, FOutputDevice& Ar) {
+	Count = Count > 0 ? Count : 1000000;
+	auto Run = [Count](int32 NumThreads, auto&& Alloc) {
+		std::atomic<int32> Ready(0);
+		std::atomic<bool> bGo(false);
+		TArray<std::thread> Threads;
+		Threads.Reserve(NumThreads);
+		for (int32 Idx = 0; Idx < NumThreads; ++Idx)
+		{
+			Threads.Emplace([&] {
+				++Ready;
+				while (!bGo)
+					std::this_thread::yield();
+				int64 Sink = 0;
+				for (int32 i = 0; i < Count; ++i)
+					Sink += Alloc();
+				GMP_CHECK(Sink);
+			});
+		}
+		while (Ready < NumThreads)
+			std::this_thread::yield();
+		const double Start = FPlatformTime::Seconds();
+		bGo = true;
+		for (auto& Thread : Threads)
+			Thread.join();
+		return (FPlatformTime::Seconds() - Start) * 1e9 / (double(Count) * NumThreads);
+	};
+
+	static std::atomic<int64> SharedCounter(0);
+	for (int32 NumThreads : {1, 8, 32})
+	{
+		const double SharedNs = Run(NumThreads, [] { return ++SharedCounter; });
+		const double BlockedNs = Run(NumThreads, [] { return FGMPKey::NextGMPKey().Key; });
+		const double SequenceNs = Run(NumThreads, [] { return GMP::FMessageBody::GetNextSequenceID().Key; });
+		Ar.Logf(TEXT("GMPKey %2d threads : shared atomic %.2fns, key blocks %.2fns, sequence blocks %.2fns per id"), NumThreads, SharedNs, BlockedNs, SequenceNs);
+	}
+});
+#endif
+
 using FOnGMPSigSourceDeleted = TMulticastDelegate<void(GMP::FSigSource)>;
 
 namespace GMP
@@ -121,6 +213,13 @@ static FCriticalSection* GetGMPCritical()
 
 #define GMP_THREAD_LOCK() FScopeLock GMPLock(GetGMPCritical())
 #define GMP_VERIFY_GAME_THREAD() GMP_CHECK(IsInGameThread())
+
+#if !UE_BUILD_SHIPPING
+// gmp.bench.handlerCleanup restores the stale sweep on every removal to measure against it
+static bool bSweepHandlersPerRemoval = false;
+#else
+static constexpr bool bSweepHandlersPerRemoval = false;
+#endif
 static TSet<TUniquePtr<FSigElm>, FSigElm::FKeyFuncs> GlobalSigElmSet;
 
 struct FSignalUtils
@@ -135,27 +234,34 @@ struct FSignalUtils
 	}
 
 	template<typename F>
-	static void RemoveOp(const FSignalStore* In, FGMPKey Key, const F& Func)
+	static void RemoveOp(FSignalStore* In, FGMPKey Key, const F& Func)
 	{
 		if (auto Find = GetSigElmSet(In).Find(Key))
 		{
 			auto Elm = Find->Get();
-#if !GMP_SIGNAL_WITH_GLOBAL_SIGELMSET
 			GMPDebug(In->MessageKey, Elm, TEXT("RemoveOp"));
-#endif
 			Func(Elm);
-			GetSigElmSet(In).Remove(Key);
+			In->EraseSigElmStorage(Elm);
 		}
 	}
-	static TArray<FGMPKey> GetSigElmSetKeys(const FSignalStore* In)
+
+	// defers element destruction until the outermost scope ends, so dispatching callers can safely hold raw FSigElm pointers
+	struct FDispatchScope
 	{
-		TArray<FGMPKey> Keys;
-		for (auto& Elem : GetSigElmSet(In))
+		FDispatchScope(FSignalStore& InStore)
+			: Store(InStore)
 		{
-			Keys.Add(Elem->GetGMPKey());
+			++Store.ScopeCnt;
 		}
-		return Keys;
-	}
+		~FDispatchScope()
+		{
+			if (--Store.ScopeCnt == 0)
+				Store.FlushPendingElms();
+		}
+
+	private:
+		FSignalStore& Store;
+	};
 
 	static void ShutdownSignal(FSignalStore* In)
 	{
@@ -173,33 +279,47 @@ struct FSignalUtils
 			ResultKeys.Append(Removed);
 		}
 
-		for (auto It = In->HandlerObjs.CreateIterator(); It; ++It)
+		// deleted handlers are routed here by their own mapping, the stale sweep only catches the ones
+		// whose deletion was deferred off the game thread, so it runs at most once per frame
+		if (bSweepHandlersPerRemoval || In->HandlerSweepFrame != GFrameCounter)
 		{
-			if (It->Key.IsStale())
+			In->HandlerSweepFrame = GFrameCounter;
+			for (auto It = In->HandlerObjs.CreateIterator(); It; ++It)
 			{
-				ResultKeys.Append(It->Value);
-				It.RemoveCurrent();
+				if (It->Key.IsStale())
+				{
+					ResultKeys.Append(It->Value);
+					It.RemoveCurrent();
+				}
 			}
 		}
 		return ResultKeys;
 	}
 
+	// listeners without a source are listed under AnySigSrc
+	static FSigSource GetListedSource(const FSigElm* SigElm) { return SigElm->GetSource().SigOrObj() ? SigElm->GetSource() : FSigSource::AnySigSrc; }
+
 	static void StaticOnObjectRemoved(FSignalStore* In, FSigSource InSigSrc)
 	{
 		GMP_VERIFY_GAME_THREAD();
-		ensure(!In->IsFiring());
-		auto Obj = InSigSrc.TryGetUObject();
-
 		GMPDebug(In->MessageKey, nullptr, TEXT("StaticOnObjectRemoved"));
 
+		// before the scope opens, so the views of this source are dropped right away instead of queued
+		In->InvalidateSourceView(InSigSrc);
+
+		FDispatchScope DispatchScope(*In);
+		auto Obj = InSigSrc.TryGetUObject();
+
 		FSignalStore::FSigElmKeySet SigKeys;
-		In->SourceObjs.RemoveAndCopyValue(InSigSrc, SigKeys);
+		FSigElmKeyList SrcKeys;
+		if (In->SourceObjs.RemoveAndCopyValue(InSigSrc, SrcKeys))
+			SigKeys.Append(SrcKeys);
 #if GMP_WITH_MSG_HOLDER
 		In->SourceMsgs.Remove(InSigSrc);
 #endif
 
-		static FSignalStore::FSigElmKeySet Dummy;
-		FSignalStore::FSigElmKeySet* Handlers = &Dummy;
+		static FSigElmKeyList Dummy;
+		FSigElmKeyList* Handlers = &Dummy;
 		if (bool bShouldIncludeWorld = bShouldClearWorldSubOjbects && Obj && (!Obj->IsA<UGameInstance>() && !Obj->IsA<UGameViewportClient>()))
 		{
 			auto ObjWorld = bShouldIncludeWorld ? Obj->GetWorld() : (UWorld*)nullptr;
@@ -231,10 +351,30 @@ struct FSignalUtils
 #if !GMP_DEBUG_SIGNAL
 		if (StorageRef.Num() > 0)
 		{
+			// emptied lists are removed afterwards, Handlers may point at one of them
+			TArray<FSigSource, TInlineAllocator<4>> Emptied;
 			for (auto SigKey : RemoveAndCopyInvalidHandlerObjs(In, SigKeys, Obj))
 			{
 				Handlers->Remove(SigKey);
-				StorageRef.Remove(SigKey);
+				if (auto SigElm = In->FindSigElm(SigKey))
+				{
+					const FSigSource SigSrc = GetListedSource(SigElm);
+					if (FSigElmKeyList* KeySet = In->SourceObjs.Find(SigSrc))
+					{
+						KeySet->Remove(SigKey);
+						if (!KeySet->Num())
+							Emptied.AddUnique(SigSrc);
+					}
+					In->EraseSigElmStorage(SigElm);
+				}
+			}
+			for (auto SigSrc : Emptied)
+			{
+				if (FSigElmKeyList* KeySet = In->SourceObjs.Find(SigSrc))
+				{
+					if (!KeySet->Num())
+						In->SourceObjs.Remove(SigSrc);
+				}
 			}
 		}
 #else
@@ -243,7 +383,7 @@ struct FSignalUtils
 			Handlers->Remove(SigKey);
 			FSignalUtils::RemoveOp(In, SigKey, [&](FSigElm* Elm) {
 				auto SigSrc = Elm->GetSource();
-				if (FSignalStore::FSigElmKeySet* KeySet = In->SourceObjs.Find(SigSrc))
+				if (FSigElmKeyList* KeySet = In->SourceObjs.Find(SigSrc))
 				{
 					KeySet->Remove(SigKey);
 					if (!KeySet->Num())
@@ -284,14 +424,7 @@ struct FSignalUtils
 		}
 
 		// Storage
-		if (!In->IsFiring())
-		{
-			In->RemoveSigElmStorage(SigElm->GetGMPKey());
-		}
-		else
-		{
-			SigElm->SetLeftTimes(0);
-		}
+		In->RemoveSigElmStorage(SigElm->GetGMPKey());
 	}
 
 	template<bool bAllowDuplicate>
@@ -300,10 +433,16 @@ struct FSignalUtils
 #if GMP_SIGNAL_WITH_GLOBAL_SIGELMSET
 		if (!In)
 		{
-			FSignalUtils::RemoveOp(In, Key, [](FSigElm* SigElm) {});
-			return;
+			auto Find = GetSigElmSet(In).Find(Key);
+			In = Find ? (*Find)->GetOwner() : nullptr;
+			if (!In)
+				return;
 		}
 #endif
+		// already disconnected while firing
+		if (In->PendingErases.Contains(Key))
+			return;
+
 		FSignalUtils::RemoveOp(In, Key, [&](FSigElm* SigElm) {
 			GMP_IF_CONSTEXPR(bAllowDuplicate)
 			{
@@ -318,9 +457,8 @@ struct FSignalUtils
 				In->HandlerObjs.Remove(SigElm->GetHandler());
 			}
 
-#if GMP_DEBUG_SIGNAL
-			auto SigSrc = SigElm->GetSource();
-			if (FSignalStore::FSigElmKeySet* KeySet = In->SourceObjs.Find(SigSrc))
+			const FSigSource SigSrc = GetListedSource(SigElm);
+			if (FSigElmKeyList* KeySet = In->SourceObjs.Find(SigSrc))
 			{
 				KeySet->Remove(Key);
 				if (!KeySet->Num())
@@ -328,7 +466,6 @@ struct FSignalUtils
 					In->SourceObjs.Remove(SigSrc);
 				}
 			}
-#endif
 		});
 	}
 
@@ -336,6 +473,7 @@ struct FSignalUtils
 	static void DisconnectObjectHandler(FSignalStore* In, const UObject* InHandler, FSigSource* InSigSrc = nullptr)
 	{
 		GMP_CHECK_SLOW(InHandler);
+		FDispatchScope DispatchScope(*In);
 		FSignalStore::FSigElmKeySet HandlerKeys;
 		if (!RemoveAndCopyInvalidHandlerObjs(In, HandlerKeys, InHandler).Num())
 			return;
@@ -397,6 +535,47 @@ public:
 
 	virtual void NotifyUObjectDeleted(const UObjectBase* ObjectBase, int32 Index) override { RouterObjectRemoved(FSigSource::RawSigSource(ObjectBase)); }
 	using FSigStoreSet = TSet<TWeakPtr<FSignalStore, FSignalBase::SPMode>>;
+
+	// source --> signal stores, sharded by source address so listens never take the global lock
+	// and deleted objects without listeners only cost a shared probe
+	struct FMessageMappings
+	{
+		static const int32 NumShards = 16;
+		struct FShard
+		{
+			FRWLock Lock;
+			TMap<FSigSource, FSigStoreSet> Mappings;
+		};
+		FShard Shards[NumShards];
+
+		FShard& GetShard(FSigSource InSigSrc) { return Shards[GetTypeHash(InSigSrc) % NumShards]; }
+		void Add(FSigSource InSigSrc, TWeakPtr<FSignalStore, FSignalBase::SPMode> InStore)
+		{
+			auto& Shard = GetShard(InSigSrc);
+			FRWScopeLock ScopeLock(Shard.Lock, SLT_Write);
+			Shard.Mappings.FindOrAdd(InSigSrc).Add(MoveTemp(InStore));
+		}
+		bool Remove(FSigSource InSigSrc, FSigStoreSet& OutStores)
+		{
+			auto& Shard = GetShard(InSigSrc);
+			{
+				FRWScopeLock ScopeLock(Shard.Lock, SLT_ReadOnly);
+				if (!Shard.Mappings.Contains(InSigSrc))
+					return false;
+			}
+			FRWScopeLock ScopeLock(Shard.Lock, SLT_Write);
+			return Shard.Mappings.RemoveAndCopyValue(InSigSrc, OutStores);
+		}
+		void Reset()
+		{
+			for (auto& Shard : Shards)
+			{
+				FRWScopeLock ScopeLock(Shard.Lock, SLT_Write);
+				Shard.Mappings.Reset();
+			}
+		}
+	};
+
 	void OnUObjectArrayShutdown()
 	{
 		GMP_THREAD_LOCK();
@@ -408,7 +587,7 @@ public:
 	}
 	void RemoveSigSourceImpl(FSigSource InSig) {
 		FSigStoreSet RemovedStores;
-		if (MessageMappings.RemoveAndCopyValue(InSig, RemovedStores))
+		if (MessageMappings.Remove(InSig, RemovedStores))
 		{
 			for (auto It = RemovedStores.CreateIterator(); It; ++It)
 			{
@@ -441,21 +620,28 @@ public:
 			GMP_THREAD_LOCK();
 			GMPSigIncs.Remove(InSigSrc);
 #endif
-			if (!GameThreadObjects.IsEmpty())
+			FlushPendingRemovals();
+			RemoveSigSourceImpl(InSigSrc);
+		}
+	}
+	// removals from other threads are reconciled once per frame, or earlier by the next game thread removal
+	void FlushPendingRemovals()
+	{
+		GMP_VERIFY_GAME_THREAD();
+		if (!GameThreadObjects.IsEmpty())
+		{
+			TArray<FSigSource*> Objs;
+			GameThreadObjects.PopAll(Objs);
+			for (FSigSource* Sig : Objs)
 			{
-				TArray<FSigSource*> Objs;
-				GameThreadObjects.PopAll(Objs);
-				for (FSigSource* Sig : Objs)
-				{
-					RemoveSigSourceImpl(**reinterpret_cast<FSigSource**>(Sig));
-				}
+				// the pointer itself is the pushed address
+				RemoveSigSourceImpl(*reinterpret_cast<FSigSource*>(&Sig));
 			}
-			RemoveSigSourceImpl(InSigSrc);
 		}
 	}
 
 	TArray<FSignalStore*, TInlineAllocator<32>> SignalStores;
-	TMap<FSigSource, FSigStoreSet> MessageMappings;
+	FMessageMappings MessageMappings;
 #if GMP_WITH_MSG_HOLDER
 	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
 	{
@@ -533,8 +719,10 @@ public:
 
 	static void AddMessageMapping(FSigSource InSigSrc, FSignalStore* InPtr)
 	{
-		if (InSigSrc.IsValid())
-			TryGet()->MessageMappings.FindOrAdd(InSigSrc).Add(InPtr->AsShared());
+		// only the shard lock is taken, listening never contends on the global lock
+		auto Deleter = GetMessageSourceDeleter();
+		if (InSigSrc.IsValid() && ensure(Deleter))
+			Deleter->MessageMappings.Add(InSigSrc, InPtr->AsShared());
 	}
 
 	void RemoveSigSourceKey(FSigSource InSigSrcKey)
@@ -582,6 +770,10 @@ void CreateGMPSourceAndHandlerDeleter()
 		});
 #endif
 		FCoreDelegates::OnPreExit.AddStatic(&FGMPSourceAndHandlerDeleter::OnPreExit);
+		FCoreDelegates::OnEndFrame.AddLambda([] {
+			if (auto Deleter = FGMPSourceAndHandlerDeleter::GetMessageSourceDeleter())
+				Deleter->FlushPendingRemovals();
+		});
 	}
 }
 void DestroyGMPSourceAndHandlerDeleter()
@@ -589,6 +781,49 @@ void DestroyGMPSourceAndHandlerDeleter()
 	FGMPSourceAndHandlerDeleter::OnPreExit();
 }
 
+#if !UE_BUILD_SHIPPING
+FXConsoleCommandLambda XVar_GMPBenchHandlerCleanup(TEXT("gmp.bench.handlerCleanup"), [](int32 Count, UWorld* InWorld) {
+	Count = Count > 0 ? Count : 10000;
+
+	auto Measure = [&](bool bSweepPerRemoval) {
+		// each object listens on itself, like actors listening to their own messages, every other one without a source
+		GMP::TSignal<false> Signal;
+		GMP::FSignalStore* Store = nullptr;
+		TArray<UObject*> Objs;
+		Objs.Reserve(Count);
+		for (int32 Idx = 0; Idx < Count; ++Idx)
+		{
+			auto Obj = NewObject<UGMPPlaceHolder>();
+			Obj->AddToRoot();
+			auto SigElm = (Idx & 1) ? Signal.Connect(Obj, [] {}) : Signal.Connect(Obj, [] {}, Obj);
+			Store = SigElm ? SigElm->GetOwner() : Store;
+			Objs.Add(Obj);
+		}
+
+		for (auto Obj : Objs)
+		{
+			Obj->RemoveFromRoot();
+			Obj->MarkAsGarbage();
+		}
+
+		TGuardValue<bool> SweepGuard(bSweepHandlersPerRemoval, bSweepPerRemoval);
+		const double StartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		const double Elapsed = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		// the source lists must not keep the keys of destroyed handlers
+		const int32 Leftover = Store ? Store->GetKeysBySrc(FSigSource::NullSigSrc).Num() : 0;
+		if (!ensureMsgf(Leftover == 0, TEXT("gmp.bench.handlerCleanup : %d keys left in the source lists"), Leftover))
+			UE_LOG(LogGMP, Error, TEXT("gmp.bench.handlerCleanup : %d keys left in the source lists"), Leftover);
+		return Elapsed;
+	};
+
+	const double ScanMs = Measure(true);
+	const double NotifyMs = Measure(false);
+	UE_LOG(LogGMP, Display, TEXT("gmp.bench.handlerCleanup : streamed out %d listeners, stale scan per removal %.3f ms, deletion notifications %.3f ms"), Count, ScanMs, NotifyMs);
+});
+#endif
+
 FDelayedAutoRegisterHelper DelayCreateDeleter(EDelayedRegisterRunPhase::PreObjectSystemReady, [] { CreateGMPSourceAndHandlerDeleter(); });
 
 #if GMP_DEBUG_SIGNAL
@@ -605,6 +840,172 @@ ISigSource::~ISigSource()
 	FSigSource::RemoveSource(this);
 }
 
+namespace
+{
+	const uint32 SigElmClassSizes[FSigElmPool::NumClasses] = {64, 96, 128, 192, 256, 384};
+	const int32 SigElmSlabMinBlocks = 4;
+	const int32 SigElmSlabMaxBlocks = 256;
+	FSigElmPool::FStats SigElmPoolStats;
+}  // namespace
+
+struct alignas(16) FSigElmPool::FBlockHeader
+{
+	union
+	{
+		FSigElmPool* Pool;  // in use, null for blocks too large for any class or left in a leaked slab
+		FBlockHeader* NextFree;  // in a free list
+	};
+	int32 ClassIdx;  // INDEX_NONE for blocks too large for any class
+};
+
+struct alignas(16) FSigElmPool::FSlab
+{
+	FSlab* Next;
+	SIZE_T Bytes;
+	int32 ClassIdx;
+	int32 NumBlocks;
+};
+
+static_assert(alignof(FSigElm) <= 16, "FSigElm alignment exceeds the pool block alignment");
+
+FSigElmPool::~FSigElmPool()
+{
+	GMP_VERIFY_GAME_THREAD();
+	if (LiveBlocks != 0)
+	{
+		// blocks still referenced would dangle, leak the slabs instead and detach their blocks from this pool
+		int64 Bytes = 0;
+		int32 Count = 0;
+		for (auto Slab = Slabs; Slab; Slab = Slab->Next)
+		{
+			const SIZE_T Stride = sizeof(FBlockHeader) + SigElmClassSizes[Slab->ClassIdx];
+			auto Mem = reinterpret_cast<uint8*>(Slab + 1);
+			for (int32 Idx = 0; Idx < Slab->NumBlocks; ++Idx)
+			{
+				auto Header = reinterpret_cast<FBlockHeader*>(Mem + Idx * Stride);
+				if (Header->Pool == this)
+					Header->Pool = nullptr;
+			}
+			Bytes += Slab->Bytes;
+			++Count;
+		}
+		SigElmPoolStats.LeakedSlabs += Count;
+		SigElmPoolStats.LeakedBytes += Bytes;
+		UE_LOG(LogGMP, Error, TEXT("FSigElmPool destroyed with %d live blocks, leaking %d slabs (%lld bytes)"), LiveBlocks, Count, Bytes);
+		ensureMsgf(false, TEXT("FSigElmPool destroyed with %d live blocks"), LiveBlocks);
+		return;
+	}
+
+	while (Slabs)
+	{
+		auto Next = Slabs->Next;
+		--SigElmPoolStats.SlabCount;
+		SigElmPoolStats.SlabBytes -= Slabs->Bytes;
+		SigElmPoolStats.FreeBlocks[Slabs->ClassIdx] -= Slabs->NumBlocks;
+		FMemory::Free(Slabs);
+		Slabs = Next;
+	}
+}
+
+void* FSigElmPool::Alloc(SIZE_T Size)
+{
+	GMP_VERIFY_GAME_THREAD();
+	int32 ClassIdx = 0;
+	while (ClassIdx < NumClasses && SigElmClassSizes[ClassIdx] < Size)
+		++ClassIdx;
+
+	if (ClassIdx == NumClasses)
+	{
+		auto Header = static_cast<FBlockHeader*>(FMemory::Malloc(sizeof(FBlockHeader) + Size, alignof(FBlockHeader)));
+		Header->Pool = nullptr;
+		Header->ClassIdx = INDEX_NONE;
+		++SigElmPoolStats.LargeBlocks;
+		return Header + 1;
+	}
+
+	if (!FreeLists[ClassIdx])
+	{
+		const int32 NumBlocks = FMath::Min(SigElmSlabMinBlocks << FMath::Min(SlabCounts[ClassIdx], 6), SigElmSlabMaxBlocks);
+		const SIZE_T Stride = sizeof(FBlockHeader) + SigElmClassSizes[ClassIdx];
+		const SIZE_T Bytes = sizeof(FSlab) + NumBlocks * Stride;
+		auto Slab = static_cast<FSlab*>(FMemory::Malloc(Bytes, alignof(FSlab)));
+		Slab->Next = Slabs;
+		Slab->Bytes = Bytes;
+		Slab->ClassIdx = ClassIdx;
+		Slab->NumBlocks = NumBlocks;
+		Slabs = Slab;
+		++SlabCounts[ClassIdx];
+
+		// thread the blocks in address order so consecutive listens land next to each other
+		auto Mem = reinterpret_cast<uint8*>(Slab + 1);
+		for (int32 Idx = NumBlocks - 1; Idx >= 0; --Idx)
+		{
+			auto Header = reinterpret_cast<FBlockHeader*>(Mem + Idx * Stride);
+			Header->NextFree = FreeLists[ClassIdx];
+			Header->ClassIdx = ClassIdx;
+			FreeLists[ClassIdx] = Header;
+		}
+		++SigElmPoolStats.SlabCount;
+		SigElmPoolStats.SlabBytes += Bytes;
+		SigElmPoolStats.FreeBlocks[ClassIdx] += NumBlocks;
+	}
+
+	auto Header = FreeLists[ClassIdx];
+	FreeLists[ClassIdx] = Header->NextFree;
+	Header->Pool = this;
+	++LiveBlocks;
+	++SigElmPoolStats.UsedBlocks[ClassIdx];
+	--SigElmPoolStats.FreeBlocks[ClassIdx];
+	return Header + 1;
+}
+
+void FSigElmPool::Free(void* Ptr)
+{
+	if (!Ptr)
+		return;
+
+	GMP_VERIFY_GAME_THREAD();
+	auto Header = static_cast<FBlockHeader*>(Ptr) - 1;
+	auto Pool = Header->Pool;
+	if (!Pool)
+	{
+		if (Header->ClassIdx == INDEX_NONE)
+		{
+			--SigElmPoolStats.LargeBlocks;
+			FMemory::Free(Header);
+		}
+		else
+		{
+			// its pool is gone, the slab stays leaked
+			--SigElmPoolStats.UsedBlocks[Header->ClassIdx];
+		}
+		return;
+	}
+
+	const int32 ClassIdx = Header->ClassIdx;
+	Header->NextFree = Pool->FreeLists[ClassIdx];
+	Pool->FreeLists[ClassIdx] = Header;
+	--Pool->LiveBlocks;
+	--SigElmPoolStats.UsedBlocks[ClassIdx];
+	++SigElmPoolStats.FreeBlocks[ClassIdx];
+}
+
+const FSigElmPool::FStats& FSigElmPool::GetStats()
+{
+	return SigElmPoolStats;
+}
+
+#if !UE_BUILD_SHIPPING
+FXConsoleCommandLambdaFull XVar_GMPSigElmPoolStats(TEXT("gmp.stats.sigElmPool"), TEXT("gmp.stats.sigElmPool"), [](UWorld* InWorld, FOutputDevice& Ar) {
+	auto& Stats = FSigElmPool::GetStats();
+	Ar.Logf(TEXT("FSigElmPool : %lld slabs, %lld bytes, %lld large blocks, %lld leaked slabs (%lld bytes)"), Stats.SlabCount, Stats.SlabBytes, Stats.LargeBlocks, Stats.LeakedSlabs, Stats.LeakedBytes);
+	for (int32 Idx = 0; Idx < FSigElmPool::NumClasses; ++Idx)
+	{
+		Ar.Logf(TEXT("  class %u : %lld used, %lld free"), SigElmClassSizes[Idx], Stats.UsedBlocks[Idx], Stats.FreeBlocks[Idx]);
+	}
+});
+#endif
+
 FSignalStore::FSignalStore()
 {
 	if (auto Deleter = FGMPSourceAndHandlerDeleter::TryGet())
@@ -621,23 +1022,27 @@ FSignalStore::~FSignalStore()
 
 void FSignalStore::Reset()
 {
-#if !GMP_SIGNAL_WITH_GLOBAL_SIGELMSET
-	FSigElmKeySet TobeRemoved;
-	for (auto& Pair : SourceObjs)
+	GMP_CHECK(!IsFiring());
+	// only release the elements owned by this store, the storage may be shared by all stores
+	auto& SigElmSet = FSignalUtils::GetSigElmSet(this);
+	for (FSigElm* SigElm : DispatchElms)
 	{
-		TobeRemoved.Append(Pair.Value);
+		SigElmSet.Remove(SigElm->GetGMPKey());
 	}
-	for (auto& Pair : HandlerObjs)
+	for (FSigElm* SigElm : PendingAdds)
 	{
-		TobeRemoved.Append(Pair.Value);
+		SigElmSet.Remove(SigElm->GetGMPKey());
 	}
-	for (auto& Key : TobeRemoved)
+	for (auto& Key : PendingErases)
 	{
-		FSignalUtils::GetSigElmSet(this).Remove(Key);
+		SigElmSet.Remove(Key);
 	}
-#else
-	FSignalUtils::GetSigElmSet(this).Reset();
-#endif
+	DispatchElms.Reset();
+	PendingAdds.Reset();
+	PendingErases.Reset();
+	SourceViews.Reset();
+	WorldViews.Reset();
+	PendingViewSources.Reset();
 	SourceObjs.Reset();
 #if GMP_WITH_MSG_HOLDER
 	SourceMsgs.Reset();
@@ -836,20 +1241,12 @@ void FSignalImpl::OnFire(const TGMPFunctionRef<void(FSigElm*)>& Invoker) const
 
 	auto StoreHolder = Store;
 	FSignalStore& StoreRef = *StoreHolder;
-	TScopeCounter<decltype(StoreRef.ScopeCnt)> ScopeCounter(StoreRef.ScopeCnt);
+	FSignalUtils::FDispatchScope DispatchScope(StoreRef);
 
-	TArray<FGMPKey> CallbackIDs = FSignalUtils::GetSigElmSetKeys(&StoreRef);
-	auto CallbackNums = CallbackIDs.Num();
+	// listeners connected during firing stay pending until the outermost fire ends
 	FMsgKeyArray EraseIDs;
-	for (auto Idx = 0; Idx < CallbackNums; ++Idx)
+	for (FSigElm* Elem : StoreRef.DispatchElms)
 	{
-		auto Key = CallbackIDs[Idx];
-		auto Elem = StoreRef.FindSigElm(Key);
-		if (!Elem)
-		{
-			EraseIDs.Add(Key);
-			continue;
-		}
 		bool bShouldErase = !Elem->IsInvokable();
 		if (!bShouldErase)
 		{
@@ -858,10 +1255,8 @@ void FSignalImpl::OnFire(const TGMPFunctionRef<void(FSigElm*)>& Invoker) const
 		}
 		if (bShouldErase)
 		{
-			EraseIDs.Add(Key);
-#if !GMP_SIGNAL_WITH_GLOBAL_SIGELMSET
+			EraseIDs.Add(Elem->GetGMPKey());
 			GMPDebug(StoreRef.MessageKey, Elem, TEXT("EraseOnFire"));
-#endif
 		}
 	}
 
@@ -880,19 +1275,14 @@ FSignalImpl::FOnFireResults FSignalImpl::OnFireWithSigSource(FSigSource InSigSrc
 
 	auto StoreHolder = Store;
 	FSignalStore& StoreRef = *StoreHolder;
-	TScopeCounter<decltype(StoreRef.ScopeCnt)> ScopeCounter(StoreRef.ScopeCnt);
+	FSignalUtils::FDispatchScope DispatchScope(StoreRef);
+
+	FSignalStore::FSigElmArray UncachedElms;
+	const FSignalStore::FSigElmArray& Elms = StoreRef.GetSourceView(InSigSrc, UncachedElms);
 
 	FMsgKeyArray EraseIDs;
-	auto CallbackIDs = StoreRef.GetKeysBySrc<FOnFireResultArray>(InSigSrc);
-	for (auto Idx = 0; Idx < CallbackIDs.Num(); ++Idx)
+	for (FSigElm* Elem : Elms)
 	{
-		auto Key = CallbackIDs[Idx];
-		auto Elem = StoreRef.FindSigElm(Key);
-		if (!Elem)
-		{
-			continue;
-		}
-
 #if GMP_DEBUG_SIGNAL
 		auto Listener = Elem->GetHandler();
 		if (!Listener.IsStale())
@@ -903,7 +1293,7 @@ FSignalImpl::FOnFireResults FSignalImpl::OnFireWithSigSource(FSigSource InSigSrc
 				continue;
 		}
 #endif
-		
+
 		bool bShouldErase = !Elem->IsInvokable();
 		if (!bShouldErase)
 		{
@@ -912,7 +1302,7 @@ FSignalImpl::FOnFireResults FSignalImpl::OnFireWithSigSource(FSigSource InSigSrc
 		}
 		if (bShouldErase)
 		{
-			EraseIDs.Add(Key);
+			EraseIDs.Add(Elem->GetGMPKey());
 #if !GMP_SIGNAL_WITH_GLOBAL_SIGELMSET
 			GMPDebug(StoreRef.MessageKey, Elem, TEXT("EraseOnFireWithSigSource"));
 #endif
@@ -927,6 +1317,10 @@ FSignalImpl::FOnFireResults FSignalImpl::OnFireWithSigSource(FSigSource InSigSrc
 		}
 	}
 #if WITH_EDITOR
+	FOnFireResultArray CallbackIDs;
+	CallbackIDs.Reserve(Elms.Num());
+	for (FSigElm* Elem : Elms)
+		CallbackIDs.Add(Elem->GetGMPKey());
 	return CallbackIDs;
 #endif
 }
@@ -979,30 +1373,47 @@ FSigElm* FSignalStore::FindSigElm(FGMPKey Key) const
 }
 
 template<typename ArrayT>
-ArrayT FSignalStore::GetKeysBySrc(FSigSource InSigSrc, bool bIncludeNoSrc) const
+void FSignalStore::MergeKeysBySrc(ArrayT& Results, FSigSource InSigSrc, FSigSource InWorld, bool bIncludeNoSrc) const
 {
-	GMP_VERIFY_GAME_THREAD();
-	ArrayT Results;
-	static auto AppendResult = [](ArrayT& Ret, const FSigElmKeySet* Set) {
-		if (Set)
-		{
-			auto Arr = Set->Array();
-			Arr.Sort();
-			Ret.Append(Arr);
-		}
+	TArray<const FSigElmKeyList*, TInlineAllocator<3>> Lists;
+	auto AddList = [&](FSigSource Src) {
+		if (auto Find = SourceObjs.Find(Src))
+			Lists.Add(Find);
 	};
-	AppendResult(Results, SourceObjs.Find(InSigSrc));
+	AddList(InSigSrc);
 
-	if (UWorld* ObjWorld = InSigSrc.GetSigSourceWorld())
+	if (InWorld)
 	{
-		AppendResult(Results, SourceObjs.Find(ObjWorld));
+		AddList(InWorld);
 	}
 
 	if (bIncludeNoSrc)
 	{
-		AppendResult(Results, SourceObjs.Find(FSigSource::AnySigSrc));
+		AddList(FSigSource::AnySigSrc);
+	}
+
+	// each list is already sorted, merge them to keep the listen order across sources
+	int32 Cursors[3] = {0, 0, 0};
+	for (;;)
+	{
+		int32 MinIdx = INDEX_NONE;
+		for (int32 i = 0; i < Lists.Num(); ++i)
+		{
+			if (Cursors[i] < Lists[i]->Num() && (MinIdx == INDEX_NONE || (*Lists[i])[Cursors[i]] < (*Lists[MinIdx])[Cursors[MinIdx]]))
+				MinIdx = i;
+		}
+		if (MinIdx == INDEX_NONE)
+			break;
+		Results.Add((*Lists[MinIdx])[Cursors[MinIdx]++]);
 	}
+}
 
+template<typename ArrayT>
+ArrayT FSignalStore::GetKeysBySrc(FSigSource InSigSrc, bool bIncludeNoSrc) const
+{
+	GMP_VERIFY_GAME_THREAD();
+	ArrayT Results;
+	MergeKeysBySrc(Results, InSigSrc, InSigSrc.GetSigSourceWorld(), bIncludeNoSrc);
 	return Results;
 }
 template TArray<FGMPKey> FSignalStore::GetKeysBySrc<TArray<FGMPKey>>(FSigSource InSigSrc, bool bIncludeNoSrc) const;
@@ -1034,7 +1445,6 @@ bool FSignalStore::IsAlive(const UObject* InHandler, FSigSource InSigSrc) const
 
 void FSignalStore::RemoveSigElmStorage(FGMPKey SigKey)
 {
-	GMP_CHECK(!IsFiring());
 #if GMP_DEBUG_SIGNAL
 	FSignalUtils::RemoveOp(this, SigKey, [&](FSigElm* SigElm) {
 		auto SigSrc = SigElm->GetSource();
@@ -1052,9 +1462,137 @@ void FSignalStore::RemoveSigElmStorage(FGMPKey SigKey)
 		ensureAlways(!Handlers || !Handlers->Contains(SigKey));
 	});
 #else
-	FSignalUtils::GetSigElmSet(this).Remove(SigKey);
+	if (auto SigElm = FindSigElm(SigKey))
+		EraseSigElmStorage(SigElm);
 #endif
 }
+
+const FSignalStore::FSigElmArray& FSignalStore::GetSourceView(FSigSource InSigSrc, FSigElmArray& Uncached)
+{
+	GMP_VERIFY_GAME_THREAD();
+	if (auto Find = SourceViews.Find(InSigSrc))
+		return (*Find)->Elms;
+
+	auto CollectElms = [&](FSigElmArray& Elms, FSigSource InWorld) {
+		TArray<FGMPKey, TInlineAllocator<16>> Keys;
+		MergeKeysBySrc(Keys, InSigSrc, InWorld, true);
+		Elms.Reserve(Keys.Num());
+		for (auto Key : Keys)
+		{
+			if (auto SigElm = FindSigElm(Key))
+				Elms.Add(SigElm);
+		}
+	};
+
+	// external sources are not routed back to the stores on removal, so their address may be reused
+	if (InSigSrc.IsValid() && !InSigSrc.SigOrObj())
+	{
+		CollectElms(Uncached, InSigSrc.GetSigSourceWorld());
+		return Uncached;
+	}
+
+	// views are boxed so building one during a nested fire never moves the one being walked
+	auto& View = SourceViews.Emplace(InSigSrc, MakeUnique<FSourceView>());
+	View->World = InSigSrc.GetSigSourceWorld();
+	CollectElms(View->Elms, View->World);
+	if (View->World)
+	{
+		WorldViews.FindOrAdd(View->World).Add(InSigSrc);
+		FGMPSourceAndHandlerDeleter::AddMessageMapping(View->World, this);
+	}
+	// get notified when the source goes away even if nothing listens on it directly
+	FGMPSourceAndHandlerDeleter::AddMessageMapping(InSigSrc, this);
+	return View->Elms;
+}
+
+void FSignalStore::InvalidateSourceView(FSigSource InSigSrc)
+{
+	if (IsFiring())
+	{
+		// views may be walked right now, drop them once the outermost fire ends
+		PendingViewSources.AddUnique(InSigSrc);
+		return;
+	}
+
+	if (!InSigSrc.SigOrObj())
+	{
+		// listeners without a source are merged into every view
+		SourceViews.Reset();
+		WorldViews.Reset();
+		return;
+	}
+
+	SourceViews.Remove(InSigSrc);
+	TArray<FSigSource> Sources;
+	if (WorldViews.RemoveAndCopyValue(InSigSrc, Sources))
+	{
+		for (auto& Src : Sources)
+		{
+			auto Find = SourceViews.Find(Src);
+			if (Find && (*Find)->World == InSigSrc)
+				SourceViews.Remove(Src);
+		}
+	}
+}
+
+void FSignalStore::AddDispatchElm(FSigElm* SigElm)
+{
+	GMP_CHECK_SLOW(!IsFiring());
+	InvalidateSourceView(SigElm->GetSource());
+	// insert into the right slot so both fire paths honour FGMPListenOptions::Order
+	auto Idx = Algo::UpperBoundBy(DispatchElms, SigElm->GetGMPKey(), [](const FSigElm* Elm) { return Elm->GetGMPKey(); });
+	DispatchElms.Insert(SigElm, Idx);
+}
+
+void FSignalStore::EraseSigElmStorage(FSigElm* SigElm)
+{
+	if (IsFiring())
+	{
+		// keep it alive for the callers still walking DispatchElms
+		SigElm->SetLeftTimes(0);
+		PendingErases.Add(SigElm->GetGMPKey());
+	}
+	else
+	{
+		InvalidateSourceView(SigElm->GetSource());
+		DispatchElms.RemoveSingle(SigElm);
+		FSignalUtils::GetSigElmSet(this).Remove(SigElm->GetGMPKey());
+	}
+}
+
+void FSignalStore::FlushPendingElms()
+{
+	GMP_CHECK(!IsFiring());
+	if (PendingErases.Num() > 0)
+	{
+		auto IsErased = [&](FSigElm* SigElm) { return PendingErases.Contains(SigElm->GetGMPKey()); };
+		DispatchElms.RemoveAll(IsErased);
+		PendingAdds.RemoveAll(IsErased);
+
+		auto& SigElmSet = FSignalUtils::GetSigElmSet(this);
+		for (auto& Key : PendingErases)
+		{
+			if (auto SigElm = FindSigElm(Key))
+				InvalidateSourceView(SigElm->GetSource());
+			SigElmSet.Remove(Key);
+		}
+		PendingErases.Reset();
+	}
+
+	if (PendingViewSources.Num() > 0)
+	{
+		auto Sources = MoveTemp(PendingViewSources);
+		PendingViewSources.Reset();
+		for (auto& Src : Sources)
+			InvalidateSourceView(Src);
+	}
+
+	for (FSigElm* SigElm : PendingAdds)
+	{
+		AddDispatchElm(SigElm);
+	}
+	PendingAdds.Reset();
+}
 #if GMP_WITH_MSG_HOLDER
 void FSignalStore::AddReferencedObjects(FReferenceCollector& Collector)
 {
@@ -1067,12 +1605,15 @@ void FSignalStore::AddReferencedObjects(FReferenceCollector& Collector)
 
 FSigElm* FSignalStore::AddSigElmImpl(FGMPKey Key, const UObject* InListener, FSigSource InSigSrc, const TGMPFunctionRef<FSigElm*()>& Ctor)
 {
+	bool bNewElm = false;
 	FSigElm* SigElm = FindSigElm(Key);
 	if (!SigElm)
 	{
 		SigElm = Ctor();
 		GMP_CHECK(SigElm);
+		SigElm->Owner = this;
 		FSignalUtils::GetSigElmSet(this).Emplace(SigElm);
+		bNewElm = true;
 	}
 
 	if (InListener)
@@ -1101,6 +1642,25 @@ FSigElm* FSignalStore::AddSigElmImpl(FGMPKey Key, const UObject* InListener, FSi
 	{
 		SourceObjs.FindOrAdd(FSigSource::AnySigSrc).Add(Key);
 	}
+
+	// handlers are removed by their own deletion notification instead of a stale scan
+	if (InListener)
+	{
+		FGMPSourceAndHandlerDeleter::AddMessageMapping(InListener, this);
+	}
+
+	// dispatch only after the source is known so the matching source views get dropped
+	if (bNewElm)
+	{
+		if (IsFiring())
+			PendingAdds.Add(SigElm);
+		else
+			AddDispatchElm(SigElm);
+	}
+	else
+	{
+		InvalidateSourceView(SigElm->GetSource());
+	}
 	FGMPSourceAndHandlerDeleter::AddMessageMapping(InSigSrc, this);
 	GMPDebug(MessageKey, SigElm, TEXT("AddSigElmImpl"));
 	return SigElm;
@@ -1115,7 +1675,7 @@ bool FSignalStore::IsAlive(FGMPKey Key) const
 bool FSignalStore::IsAlive() const
 {
 	GMP_VERIFY_GAME_THREAD();
-	for (auto& Elm : FSignalUtils::GetSigElmSet(this))
+	for (FSigElm* Elm : DispatchElms)
 	{
 		return !Elm->GetHandler().IsStale();
 	}
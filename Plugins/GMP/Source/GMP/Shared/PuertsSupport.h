@@ -46,6 +46,117 @@ void BindWeakCallback(v8::Isolate* InIsolate, const v8::Local<v8::Object>& JsObj
 }
 using namespace puerts;
 
+// translators are resolved once per type name and shared by all listeners
+// entries of blueprint types are dropped when their type is reinstanced or collected, Generation tells listeners to resolve again
+struct FTranslatorCache
+{
+	struct FEntry
+	{
+		TWeakObjectPtr<UField> Type;
+		FProperty* Prop = nullptr;
+		FPropertyTranslator* Inc = nullptr;
+	};
+	TMap<FName, FEntry> Entries;
+	uint32 Generation = 0;
+
+	static FTranslatorCache& Get()
+	{
+		static FTranslatorCache Ins;
+		return Ins;
+	}
+
+	static bool IsStale(const FEntry& Entry)
+	{
+		return Entry.Type.IsStale() || (Entry.Type.IsValid() && Entry.Type->HasAnyFlags(RF_NewerVersionExists));
+	}
+
+	void Prune(bool bAll)
+	{
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (bAll || IsStale(It->Value))
+			{
+				delete It->Value.Inc;
+				It.RemoveCurrent();
+				++Generation;
+			}
+		}
+	}
+
+private:
+	FTranslatorCache()
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([this] { Prune(false); });
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([this](const auto&) { Prune(true); });
+#endif
+	}
+};
+
+inline FPropertyTranslator* FindTranslator(FName TypeName, FProperty** OutProp = nullptr)
+{
+	auto& Translators = FTranslatorCache::Get();
+	auto Find = Translators.Entries.Find(TypeName);
+	if (Find && FTranslatorCache::IsStale(*Find))
+	{
+		delete Find->Inc;
+		Translators.Entries.Remove(TypeName);
+		++Translators.Generation;
+		Find = nullptr;
+	}
+	if (!Find)
+	{
+		FProperty* Prop = nullptr;
+		if (!GMPReflection::PropertyFromName(TypeName, Prop) || !Prop)
+			return nullptr;
+		auto Inc = FPropertyTranslator::Create(Prop).release();
+		if (!Inc)
+			return nullptr;
+		Find = &Translators.Entries.Add(TypeName, {GMPReflection::PropertyTypeObject(Prop), Prop, Inc});
+	}
+	if (OutProp)
+		*OutProp = Find->Prop;
+	return Find->Inc;
+}
+
+// each listener keeps the translators of the last signature it received
+struct FSignatureCache
+{
+	TArray<FName, TInlineAllocator<8>> TypeNames;
+	TArray<FPropertyTranslator*, TInlineAllocator<8>> Incs;
+	uint32 Generation = 0;
+
+	template<typename F>
+	bool Resolve(int32 NumArgs, const F& GetTypeName)
+	{
+		bool bSame = Generation == FTranslatorCache::Get().Generation && TypeNames.Num() == NumArgs;
+		for (auto Idx = 0; bSame && Idx < NumArgs; ++Idx)
+			bSame = TypeNames[Idx] == GetTypeName(Idx);
+		if (bSame)
+			return true;
+
+		TypeNames.Reset();
+		Incs.Reset();
+		for (auto Idx = 0; Idx < NumArgs; ++Idx)
+		{
+			FName TypeName = GetTypeName(Idx);
+			auto Inc = FindTranslator(TypeName);
+			if (!Inc)
+			{
+				GMP_ERROR(TEXT("cannot get property from [%s]"), *TypeName.ToString());
+				TypeNames.Reset();
+				Incs.Reset();
+				return false;
+			}
+			TypeNames.Add(TypeName);
+			Incs.Add(Inc);
+		}
+		// resolving may have dropped a stale entry
+		Generation = FTranslatorCache::Get().Generation;
+		return true;
+	}
+};
+
 // function ListenObjectMessage(watchedobj, msgkey, weakobj, function [,times])
 // function ListenObjectMessage(watchedobj, msgkey, weakobj, globalfuncstr [,times])
 inline void v8_ListenObjectMessage(const v8::FunctionCallbackInfo<v8::Value>& Info)
@@ -99,6 +210,7 @@ inline void v8_ListenObjectMessage(const v8::FunctionCallbackInfo<v8::Value>& In
 		{
 			v8::Global<v8::Context> ContextHandle;
 			v8::Global<v8::Function> FuncHandle;
+			FSignatureCache SigCache;
 			CallbackHolder(v8::Isolate* InIsolate, v8::Local<v8::Function>& InFunc)
 				: ContextHandle(InIsolate, InIsolate->GetCurrentContext())
 				, FuncHandle(InIsolate, InFunc)
@@ -129,8 +241,8 @@ inline void v8_ListenObjectMessage(const v8::FunctionCallbackInfo<v8::Value>& In
 					return;
 #endif
 
-				auto Types = Body.GetMessageTypes(WeakObj);
 #if !GMP_WITH_TYPENAME
+				auto Types = Body.GetMessageTypes(WeakObj);
 				if (!ensureMsgf(Types, TEXT("unable to verify sig from %s"), *Body.MessageKey().ToString()))
 				{
 					GMP_WARNING(TEXT("GetMessageTypes is null"));
@@ -147,25 +259,8 @@ inline void v8_ListenObjectMessage(const v8::FunctionCallbackInfo<v8::Value>& In
 #endif
 
 				const int32 NumArgs = Addrs.Num();
-				bool bSucc = true;
-				TArray<std::unique_ptr<FPropertyTranslator>, TInlineAllocator<8>> Incs;
-				for (auto Idx = 0; Idx < NumArgs; ++Idx)
-				{
-					FProperty* Prop = nullptr;
-					if (GMPReflection::PropertyFromString(GetTypeName(Idx).ToString(), Prop) && Prop)
-					{
-						auto Inc = FPropertyTranslator::Create(Prop);
-						if (Inc)
-						{
-							Incs.Add(std::move(Inc));
-							continue;
-						}
-					}
-
-					GMP_ERROR(TEXT("cannot get property from [%s]"), *GetTypeName(Idx).ToString());
-					bSucc = false;
-					break;
-				}
+				bool bSucc = Holder->SigCache.Resolve(NumArgs, GetTypeName);
+				auto& Incs = Holder->SigCache.Incs;
 
 				if (bSucc)
 				{
@@ -274,11 +369,7 @@ inline void v8_NotifyObjectMessage(const v8::FunctionCallbackInfo<v8::Value>& In
 		for (auto i = 2; i < NumArgs; ++i)
 		{
 			FProperty* Prop = nullptr;
-			if (!GMPReflection::PropertyFromString((*Types)[i - 2].ToString(), Prop))
-			{
-				return;
-			}
-			auto Inc = FPropertyTranslator::Create(Prop);
+			auto Inc = FindTranslator((*Types)[i - 2], &Prop);
 			if (!Inc)
 				return;
 
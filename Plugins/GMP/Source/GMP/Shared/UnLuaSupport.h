@@ -23,6 +23,111 @@ extern UnLua::ITypeInterface* CreateTypeInterface(lua_State* L, int32 Idx);
 
 GMP_EXTERNAL_SIGSOURCE(lua_State)
 
+// type interfaces are resolved once per type name and shared by all listeners
+// entries of blueprint types are dropped when their type is reinstanced or collected, Generation tells listeners to resolve again
+struct FGMPUnluaTypeInterfaces
+{
+	struct FEntry
+	{
+		TWeakObjectPtr<UField> Type;
+		UnLua::ITypeInterface* Inc = nullptr;
+	};
+	TMap<FName, FEntry> Entries;
+	uint32 Generation = 0;
+
+	static FGMPUnluaTypeInterfaces& Get()
+	{
+		static FGMPUnluaTypeInterfaces Ins;
+		return Ins;
+	}
+
+	static bool IsStale(const FEntry& Entry)
+	{
+		return Entry.Type.IsStale() || (Entry.Type.IsValid() && Entry.Type->HasAnyFlags(RF_NewerVersionExists));
+	}
+
+	void Prune(bool bAll)
+	{
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (bAll || IsStale(It->Value))
+			{
+				delete It->Value.Inc;
+				It.RemoveCurrent();
+				++Generation;
+			}
+		}
+	}
+
+private:
+	FGMPUnluaTypeInterfaces()
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([this] { Prune(false); });
+#if WITH_EDITOR
+		FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([this](const auto&) { Prune(true); });
+#endif
+	}
+};
+
+inline UnLua::ITypeInterface* FindGMPTypeInterface(FName TypeName)
+{
+	auto& TypeInterfaces = FGMPUnluaTypeInterfaces::Get();
+	if (auto Find = TypeInterfaces.Entries.Find(TypeName))
+	{
+		if (!FGMPUnluaTypeInterfaces::IsStale(*Find))
+			return Find->Inc;
+		delete Find->Inc;
+		TypeInterfaces.Entries.Remove(TypeName);
+		++TypeInterfaces.Generation;
+	}
+
+	FProperty* Prop = nullptr;
+	UnLua::ITypeInterface* Inc = nullptr;
+	if (GMPReflection::PropertyFromName(TypeName, Prop) && Prop)
+		Inc = CreateTypeInterface(Prop);
+	if (Inc)
+		TypeInterfaces.Entries.Add(TypeName, {GMPReflection::PropertyTypeObject(Prop), Inc});
+	return Inc;
+}
+
+// each listener keeps the type interfaces of the last signature it received
+struct FGMPUnluaSignatureCache
+{
+	TArray<FName, TInlineAllocator<8>> TypeNames;
+	TArray<UnLua::ITypeInterface*, TInlineAllocator<8>> Incs;
+	uint32 Generation = 0;
+
+	template<typename F>
+	bool Resolve(int32 NumArgs, const F& GetTypeName)
+	{
+		bool bSame = Generation == FGMPUnluaTypeInterfaces::Get().Generation && TypeNames.Num() == NumArgs;
+		for (auto i = 0; bSame && i < NumArgs; ++i)
+			bSame = TypeNames[i] == GetTypeName(i);
+		if (bSame)
+			return true;
+
+		TypeNames.Reset();
+		Incs.Reset();
+		for (auto i = 0; i < NumArgs; ++i)
+		{
+			FName TypeName = GetTypeName(i);
+			auto Inc = FindGMPTypeInterface(TypeName);
+			if (!Inc)
+			{
+				GMP_ERROR(TEXT("[GMPUnlua] cannot get property from [%s]"), *TypeName.ToString());
+				TypeNames.Reset();
+				Incs.Reset();
+				return false;
+			}
+			TypeNames.Add(TypeName);
+			Incs.Add(Inc);
+		}
+		// resolving may have dropped a stale entry
+		Generation = FGMPUnluaTypeInterfaces::Get().Generation;
+		return true;
+	}
+};
+
 #define GMP_LOG_UNLUA_INVOKE (!UE_BUILD_SHIPPING)
 #if GMP_LOG_UNLUA_INVOKE
 static bool bLogGMPUnluaExecution = false;
@@ -173,7 +278,7 @@ inline int Lua_ListenObjectMessage(lua_State* L)
 			WatchedObject ? FGMPSigSource(WatchedObject) : FGMPSigSource(L),
 			MsgKey,
 			WeakObj,
-			[LubCb{FLubCb(lua_cb)}, WatchedObject, TableObj](GMP::FMessageBody& Body) {
+			[LubCb{FLubCb(lua_cb)}, WatchedObject, TableObj, SigCache{MakeShared<FGMPUnluaSignatureCache>()}](GMP::FMessageBody& Body) {
 				lua_State* L = UnLua::GetState();
 				if (!ensure(L))
 				{
@@ -181,14 +286,12 @@ inline int Lua_ListenObjectMessage(lua_State* L)
 					return;
 				}
 
-				bool bSucc = true;
 				auto& Addrs = Body.GetParams();
 				const int32 NumArgs = Addrs.Num();
 
-				TArray<UnLua::ITypeInterface*, TInlineAllocator<8>> Incs;
-				auto Types = Body.GetMessageTypes(WatchedObject);
-
+				// the message types lookup is only needed when addresses carry no type name
 #if !GMP_WITH_TYPENAME
+				auto Types = Body.GetMessageTypes(WatchedObject);
 				if (!ensure(Types))
 				{
 					GMP_ERROR(TEXT("[GMPUnlua] unable to verify sig from %s"), *Body.MessageKey().ToString());
@@ -204,23 +307,8 @@ inline int Lua_ListenObjectMessage(lua_State* L)
 #endif
 				};
 
-				for (auto i = 0; i < NumArgs; ++i)
-				{
-					FProperty* Prop = nullptr;
-					if (GMPReflection::PropertyFromString(GetTypeName(i).ToString(), Prop) && Prop)
-					{
-						using namespace UnLua;
-						if (auto Inc = CreateTypeInterface(Prop))
-						{
-							Incs.Add(Inc);
-							continue;
-						}
-					}
-
-					GMP_ERROR(TEXT("[GMPUnlua] cannot get property from [%s]"), *GetTypeName(i).ToString());
-					bSucc = false;
-					break;
-				}
+				bool bSucc = SigCache->Resolve(NumArgs, GetTypeName);
+				auto& Incs = SigCache->Incs;
 
 				lua_settop(L, 0);
 				if (bSucc)